@@ -1,12 +1,27 @@
 #include "sample_library.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <exception>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <mutex>
+#include <random>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #define MAX_LENGTH 1000
+#define BATCH_CHUNK_SIZE 4096
+#define MAX_THREADS 256
+#define MAX_CHAOTIC_DIGITS 20000
 
 // Print the menu
 void printMenu() {
@@ -80,25 +95,24 @@ void calcAndExport(const BigInt &a, const BigInt &b,
     std::cout << "a - b = " << diff << std::endl;
     std::cout << "a * b = " << prod << std::endl;
   }
-  outputFile << sum << std::endl;
-  outputFile << diff << std::endl;
-  outputFile << prod << std::endl;
+  outputFile << sum << '\n';
+  outputFile << diff << '\n';
+  outputFile << prod << '\n';
   try {
-    BigInt idiv(a / b);
-    BigInt mod(a % b);
+    std::pair<BigInt, BigInt> qr = BigInt::divmod(a, b);
     if (printConsole) {
-      std::cout << "a / b = " << idiv << std::endl;
-      std::cout << "a % b = " << mod << std::endl;
+      std::cout << "a / b = " << qr.first << std::endl;
+      std::cout << "a % b = " << qr.second << std::endl;
     }
-    outputFile << a / b << std::endl;
-    outputFile << a % b << std::endl;
+    outputFile << qr.first << '\n';
+    outputFile << qr.second << '\n';
   } catch (std::logic_error &e) {
     if (printConsole) {
       std::cout << "a / b = " << e.what() << std::endl;
       std::cout << "a % b = " << e.what() << std::endl;
     }
-    outputFile << "NULL" << std::endl;
-    outputFile << "NULL" << std::endl;
+    outputFile << "NULL" << '\n';
+    outputFile << "NULL" << '\n';
   }
   outputFile.close();
   if (printConsole) {
@@ -106,37 +120,411 @@ void calcAndExport(const BigInt &a, const BigInt &b,
   }
 }
 
+// Append the five results of a and b to out, one per line, in the same order
+// as calcAndExport(). The product is accumulated onto 0 by the column kernel,
+// which has no timeout. If b = 0 then the quotient and remainder are written as
+// "NULL". Any other error, such as a division timeout, propagates to the
+// caller.
+void appendResults(const BigInt &a, const BigInt &b, std::string &out) {
+  out += (a + b).toString();
+  out += '\n';
+  out += (a - b).toString();
+  out += '\n';
+  BigInt product;
+  out += BigInt::addmul(product, a, b).toString();
+  out += '\n';
+  try {
+    std::pair<BigInt, BigInt> qr = BigInt::divmod(a, b);
+    out += qr.first.toString();
+    out += '\n';
+    out += qr.second.toString();
+    out += '\n';
+  } catch (std::logic_error &e) {
+    out += "NULL\nNULL\n";
+  }
+}
+
+// Parse a thread count given on the command line. Throw if it is not a number
+// in [1, MAX_THREADS].
+unsigned int parseThreadCount(const std::string &value) {
+  if (value.empty() || value.size() > 4 ||
+      value.find_first_not_of("0123456789") != std::string::npos ||
+      std::stoi(value) < 1 || std::stoi(value) > MAX_THREADS) {
+    throw std::invalid_argument("Thread count must be a number from 1 to " +
+                                std::to_string(MAX_THREADS) + ", got " +
+                                value + ".");
+  }
+  return std::stoi(value);
+}
+
+// Options of chaotic mode. Digit counts of a and b are drawn from
+// [minDigits, maxDigits], uniformly or uniformly in log scale, and case i is
+// generated from a seed derived from seed and i, so the same options always
+// reproduce the same corpus.
+struct ChaoticOptions {
+  int cases = 50;
+  int minDigits = 1;
+  int maxDigits = MAX_LENGTH;
+  bool logScale = false;
+  std::uint64_t seed = 0;
+  unsigned int threads = 0;
+};
+
+// Derive the seed of case index from the master seed (SplitMix64)
+std::uint64_t caseSeed(std::uint64_t seed, std::uint64_t index) {
+  std::uint64_t z = seed + (index + 1) * 0x9e3779b97f4a7c15ULL;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
 // Chaotic mode: Randomly generate input and output to seperated folders. For
-// testcase generation only. It will generate 50 testcases, each with two random
-// integers a and b, then write the input to test.inp and the output to
-// test.out.
-void chaoticMode() {
+// testcase generation only. It generates options.cases testcases, each with two
+// random integers a and b, then writes the input to test.inp and the output to
+// test.out. Cases are spread over a pool of threads. Only division by zero is
+// written as "NULL"; if a case fails otherwise, e.g. a kernel timeout on large
+// operands, no further cases are generated and the error is rethrown, so the
+// corpus never depends on the speed of the machine.
+void chaoticMode(const ChaoticOptions &options) {
+  if (options.cases <= 0 || options.minDigits <= 0 ||
+      options.maxDigits < options.minDigits) {
+    throw std::invalid_argument("Chaotic mode needs a positive case count and "
+                                "0 < min digits <= max digits.");
+  }
+  // The division of the last case must finish well within its timeout
+  if (options.maxDigits > MAX_CHAOTIC_DIGITS) {
+    throw std::invalid_argument(
+        "Max digits must be at most " + std::to_string(MAX_CHAOTIC_DIGITS) +
+        ", the largest size the division kernel finishes within its "
+        "timeout.");
+  }
   std::filesystem::create_directories("testcases");
-  for (int i = 0; i < 50; ++i) {
-    std::cout << "Generating test case #" << i + 1 << "..." << std::endl;
-    int raa = rand() % 1001;
-    int rab = rand() % 1001;
-    // Special case: a = 1000, b = 500 for extreme division test.
-    if (i == 49) {
-      raa = 1000;
-      rab = 500;
+  unsigned int threads = options.threads;
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  std::cout << "Generating " << options.cases << " test cases with seed "
+            << options.seed << "..." << std::endl;
+
+  std::atomic<int> next(0);
+  std::mutex consoleMutex;
+  std::atomic<bool> failed(false);
+  std::string error;
+  auto generate = [&] {
+    for (int i = next++; i < options.cases && !failed; i = next++) {
+      std::mt19937_64 gen(caseSeed(options.seed, i));
+      int raa, rab;
+      if (options.logScale) {
+        std::uniform_real_distribution<double> dis(
+            std::log(options.minDigits), std::log(options.maxDigits + 1));
+        raa = std::min(options.maxDigits, int(std::exp(dis(gen))));
+        rab = std::min(options.maxDigits, int(std::exp(dis(gen))));
+      } else {
+        std::uniform_int_distribution<int> dis(options.minDigits,
+                                               options.maxDigits);
+        raa = dis(gen);
+        rab = dis(gen);
+      }
+      // Special case: the last test is the largest a with half-length b for
+      // extreme division test.
+      if (i == options.cases - 1) {
+        raa = options.maxDigits;
+        rab = std::max(options.minDigits, options.maxDigits / 2);
+      }
+      BigInt ra(randomize(gen, raa));
+      BigInt rb(randomize(gen, rab));
+      std::string results;
+      try {
+        appendResults(ra, rb, results);
+      } catch (std::exception &e) {
+        std::lock_guard<std::mutex> lock(consoleMutex);
+        if (!failed) {
+          error = "Test case #" + std::to_string(i + 1) + " failed: " +
+                  e.what() + " Reduce --max-digits or see --help.";
+        }
+        failed = true;
+        return;
+      }
+      std::string path = "testcases/testcase_" + std::to_string(i + 1);
+      std::filesystem::create_directories(path);
+      std::ofstream inputFile(path + "/test.inp");
+      inputFile << ra << " " << rb;
+      inputFile.close();
+      std::ofstream outputFile(path + "/test.out", std::ios::binary);
+      outputFile.write(results.data(), results.size());
+      outputFile.close();
+      std::lock_guard<std::mutex> lock(consoleMutex);
+      std::cout << "Generated test case #" << i + 1 << std::endl;
     }
-    BigInt ra(randomize(raa));
-    BigInt rb(randomize(rab));
-    std::stringstream ss;
-    ss << "testcase_" << i + 1;
-    std::string path = "testcases/" + ss.str();
-    std::filesystem::create_directories(path);
-    std::ofstream inputFile(path + "/test.inp");
-    inputFile << ra << " " << rb;
-    inputFile.close();
-    calcAndExport(ra, rb, path + "/test.out", false);
+  };
+  std::vector<std::thread> workers;
+  for (unsigned int i = 1; i < threads; ++i) {
+    workers.emplace_back(generate);
+  }
+  generate();
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+  if (failed) {
+    throw std::runtime_error(error);
   }
   std::cout << "All files generated" << std::endl;
-  return;
 }
-// Main function
-int main() {
+
+// Bounded queue shared by the batch pipeline stages. push() blocks while the
+// queue is full and pop() blocks while it is empty. After close(), pop()
+// returns false once the queue is drained.
+template <typename T> class BlockingQueue {
+public:
+  explicit BlockingQueue(std::size_t capacity) : capacity(capacity) {}
+
+  void push(T item) {
+    std::unique_lock<std::mutex> lock(mutex);
+    notFull.wait(lock, [this] { return items.size() < capacity; });
+    items.push_back(std::move(item));
+    notEmpty.notify_one();
+  }
+
+  bool pop(T &item) {
+    std::unique_lock<std::mutex> lock(mutex);
+    notEmpty.wait(lock, [this] { return !items.empty() || closed; });
+    if (items.empty()) {
+      return false;
+    }
+    item = std::move(items.front());
+    items.pop_front();
+    notFull.notify_one();
+    return true;
+  }
+
+  void close() {
+    std::lock_guard<std::mutex> lock(mutex);
+    closed = true;
+    notEmpty.notify_all();
+  }
+
+private:
+  std::size_t capacity;
+  std::deque<T> items;
+  bool closed = false;
+  std::mutex mutex;
+  std::condition_variable notEmpty;
+  std::condition_variable notFull;
+};
+
+// A block of input lines and the results computed for them
+struct BatchChunk {
+  std::size_t index = 0;
+  std::vector<std::string> lines;
+  std::string output;
+};
+
+// Batch mode: read "a b" pairs, one per line, from inputName and write the
+// five results of each pair to outputName in input order. The reader, the
+// worker pool and the writer run concurrently and exchange chunks of lines,
+// so parsing and arithmetic overlap with file I/O. A blank or malformed line
+// gets five "NULL" lines, so output block N always belongs to input line N. If
+// a pair fails for any other reason, e.g. a kernel timeout, the output file is
+// removed and the error is rethrown.
+void batchMode(const std::string &inputName, const std::string &outputName,
+               unsigned int threads) {
+  std::ifstream inputFile(inputName);
+  if (!inputFile.is_open()) {
+    throw std::invalid_argument("Input file " + inputName +
+                                " is not exist or not found.");
+  }
+  std::ofstream outputFile(outputName, std::ios::binary);
+  if (!outputFile.is_open()) {
+    throw std::invalid_argument("Output file " + outputName +
+                                " cannot be created.");
+  }
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  // Credits bound the number of chunks in flight, so a slow chunk cannot make
+  // the writer buffer the rest of the file while it waits for it.
+  const std::size_t window = 4 * threads;
+  BlockingQueue<int> credits(window);
+  for (std::size_t i = 0; i < window; ++i) {
+    credits.push(0);
+  }
+  BlockingQueue<BatchChunk> pending(window);
+  BlockingQueue<BatchChunk> done(window);
+
+  // The first error raised by a worker. Once set, the stages stop computing
+  // and writing and only drain the chunks already in flight.
+  std::mutex errorMutex;
+  std::exception_ptr error;
+  std::atomic<bool> failed(false);
+
+  std::thread reader([&] {
+    std::size_t index = 0;
+    std::string line;
+    int credit;
+    while (inputFile && !failed && credits.pop(credit)) {
+      BatchChunk chunk;
+      chunk.index = index++;
+      while (chunk.lines.size() < BATCH_CHUNK_SIZE &&
+             std::getline(inputFile, line)) {
+        chunk.lines.push_back(std::move(line));
+      }
+      pending.push(std::move(chunk));
+    }
+    pending.close();
+  });
+
+  std::vector<std::thread> workers;
+  for (unsigned int i = 0; i < threads; ++i) {
+    workers.emplace_back([&] {
+      BatchChunk chunk;
+      while (pending.pop(chunk)) {
+        try {
+          for (const std::string &line : chunk.lines) {
+            if (failed) {
+              break;
+            }
+            std::istringstream ss(line);
+            std::string aStr, bStr;
+            ss >> aStr >> bStr;
+            BigInt a, b;
+            try {
+              a = BigInt(aStr);
+              b = BigInt(bStr);
+            } catch (std::invalid_argument &e) {
+              chunk.output += "NULL\nNULL\nNULL\nNULL\nNULL\n";
+              continue;
+            }
+            appendResults(a, b, chunk.output);
+          }
+        } catch (std::exception &e) {
+          std::lock_guard<std::mutex> lock(errorMutex);
+          if (!error) {
+            error = std::current_exception();
+          }
+          failed = true;
+        }
+        chunk.lines.clear();
+        done.push(std::move(chunk));
+      }
+    });
+  }
+
+  std::thread writer([&] {
+    std::map<std::size_t, std::string> outOfOrder;
+    std::size_t next = 0;
+    BatchChunk chunk;
+    while (done.pop(chunk)) {
+      outOfOrder[chunk.index] = std::move(chunk.output);
+      for (auto it = outOfOrder.begin();
+           it != outOfOrder.end() && it->first == next;
+           it = outOfOrder.erase(it), ++next) {
+        if (!failed) {
+          outputFile.write(it->second.data(), it->second.size());
+        }
+        credits.push(0);
+      }
+    }
+  });
+
+  reader.join();
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+  done.close();
+  writer.join();
+  outputFile.close();
+  if (error) {
+    std::filesystem::remove(outputName);
+    std::rethrow_exception(error);
+  }
+}
+
+// Parse the options of "TemplateApp --chaotic", given as flag-value pairs
+ChaoticOptions parseChaoticOptions(int argc, char *argv[]) {
+  ChaoticOptions options;
+  options.seed = std::random_device{}();
+  for (int i = 2; i < argc; i += 2) {
+    std::string flag = argv[i];
+    if (i + 1 >= argc) {
+      throw std::invalid_argument("Missing value for " + flag + ".");
+    }
+    std::string value = argv[i + 1];
+    if (flag == "--cases") {
+      options.cases = std::stoi(value);
+    } else if (flag == "--min-digits") {
+      options.minDigits = std::stoi(value);
+    } else if (flag == "--max-digits") {
+      options.maxDigits = std::stoi(value);
+    } else if (flag == "--distribution" &&
+               (value == "uniform" || value == "log")) {
+      options.logScale = value == "log";
+    } else if (flag == "--seed") {
+      options.seed = std::stoull(value);
+    } else if (flag == "--threads") {
+      options.threads = parseThreadCount(value);
+    } else {
+      throw std::invalid_argument("Unknown option " + flag + " " + value + ".");
+    }
+  }
+  return options;
+}
+
+// Print the command line usage
+void printUsage(const char *name) {
+  std::cout
+      << "Usage: " << name << "\n"
+      << "       " << name << " --batch <input> <output> [threads]\n"
+      << "       " << name
+      << " --chaotic [--cases N] [--min-digits N] [--max-digits N]\n"
+      << "           [--distribution uniform|log] [--seed S] [--threads N]\n"
+      << "\n"
+      << "Without arguments, run the interactive menu.\n"
+      << "--batch reads one \"a b\" pair per line and writes a + b, a - b, "
+         "a * b, a / b\n"
+      << "  and a % b per pair; blank or malformed lines and b = 0 give "
+         "NULL.\n"
+      << "--chaotic generates test cases into the testcases folder, with "
+         "--max-digits\n"
+      << "  at most " << MAX_CHAOTIC_DIGITS << ".\n"
+      << "\n"
+      << "Division gives up after 13 seconds. A pair that hits the limit "
+         "fails the\n"
+      << "whole run instead of being written as NULL.\n";
+}
+
+// Main function. Run without arguments for the interactive menu, or as
+// "TemplateApp --batch <input> <output> [threads]" to process a file of pairs,
+// or as "TemplateApp --chaotic [--cases N] [--min-digits N] [--max-digits N]
+// [--distribution uniform|log] [--seed S] [--threads N]" to generate testcases.
+// "TemplateApp --help" prints the usage.
+int main(int argc, char *argv[]) {
+  if (argc > 1 && std::string(argv[1]) == "--help") {
+    printUsage(argv[0]);
+    return 0;
+  }
+  if (argc > 1 && std::string(argv[1]) == "--batch") {
+    if (argc < 4) {
+      printUsage(argv[0]);
+      return 1;
+    }
+    try {
+      batchMode(argv[2], argv[3], argc > 4 ? parseThreadCount(argv[4]) : 0);
+    } catch (std::exception &e) {
+      std::cout << e.what() << std::endl;
+      return 1;
+    }
+    return 0;
+  }
+  if (argc > 1 && std::string(argv[1]) == "--chaotic") {
+    try {
+      chaoticMode(parseChaoticOptions(argc, argv));
+    } catch (std::exception &e) {
+      std::cout << e.what() << std::endl;
+      return 1;
+    }
+    return 0;
+  }
   BigInt a, b, sum, diff, prod, idiv, mod;
   std::string choice = "";
   do {
@@ -162,7 +550,14 @@ int main() {
       }
       break;
     } else if (choice == "3") {
-      chaoticMode();
+      ChaoticOptions options;
+      options.seed = std::random_device{}();
+      try {
+        chaoticMode(options);
+      } catch (std::exception &e) {
+        std::cout << e.what() << std::endl;
+        return 1;
+      }
       break;
     } else if (choice == "4") {
       std::cout << "Goodbye!" << std::endl;
@@ -0,0 +1,596 @@
+#ifndef FIXED_BIGINT_H
+#define FIXED_BIGINT_H
+#include "sample_library.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Fixed-width signed integer of Bits bits, stored inline as two's complement
+// little-endian limbs. It offers the same operators as BigInt but never
+// allocates. Results of arithmetic that do not fit wrap around modulo 2^Bits.
+// Conversions from long long, strings and BigInts throw overflow_error instead.
+template <std::size_t Bits> class FixedBigInt {
+  static_assert(Bits > 0 && Bits % 32 == 0,
+                "FixedBigInt width must be a positive multiple of 32 bits.");
+
+public:
+  // Number of limbs
+  static constexpr std::size_t size = Bits / 32;
+
+  // Constructors
+
+  constexpr FixedBigInt() : limbs{} {}
+  constexpr FixedBigInt(long long value) : limbs{} {
+    if (size == 1 && (value < -2147483648LL || value > 2147483647LL)) {
+      throw std::overflow_error("Number does not fit in " +
+                                std::to_string(Bits) + " bits.");
+    }
+    // Sign-extend the two's complement representation of value
+    std::uint64_t bits = static_cast<std::uint64_t>(value);
+    limb fill = value < 0 ? ~limb(0) : 0;
+    for (std::size_t i = 0; i < size; ++i) {
+      limbs[i] = i == 0 ? limb(bits) : i == 1 ? limb(bits >> 32) : fill;
+    }
+  }
+  FixedBigInt(const std::string &str) : limbs{} {
+    std::size_t start =
+        !str.empty() && (str[0] == '-' || str[0] == '+') ? 1 : 0;
+    // A sign alone has no digits
+    if (str.length() == start) {
+      throw std::invalid_argument("Invalid input. Now set to default value 0. "
+                                  "Please re-check your input.");
+    }
+    bool negative = str[0] == '-';
+    for (std::size_t i = start; i < str.length(); ++i) {
+      if (str[i] < '0' || str[i] > '9') {
+        throw std::invalid_argument(
+            "Your BigInt number contains non-digit characters " +
+            str.substr(i, 1) + " with ASCII value " + std::to_string(str[i]) +
+            ". Now set to default value 0. Please re-check your input.");
+      }
+      if (mulAdd(limbs, 10, limb(str[i] - '0')) != 0) {
+        throw std::overflow_error("Number does not fit in " +
+                                  std::to_string(Bits) + " bits.");
+      }
+    }
+    setMagnitude(negative);
+  }
+  explicit FixedBigInt(const BigInt &num) : limbs{} {
+    std::vector<limb> magnitude = num.toLimbs(size);
+    for (std::size_t i = 0; i < size; ++i) {
+      limbs[i] = magnitude[i];
+    }
+    setMagnitude(num.isNegative);
+  }
+
+  // Widen a narrower FixedBigInt by sign extension
+  template <std::size_t Other, typename = std::enable_if_t<(Other < Bits)>>
+  constexpr FixedBigInt(const FixedBigInt<Other> &other) : limbs{} {
+    constexpr std::size_t otherSize = Other / 32;
+    limb fill = other.data()[otherSize - 1] >> 31 ? ~limb(0) : 0;
+    for (std::size_t i = 0; i < size; ++i) {
+      limbs[i] = i < otherSize ? other.data()[i] : fill;
+    }
+  }
+
+  // Build from raw two's complement limbs
+  static constexpr FixedBigInt fromLimbs(const std::array<limb, size> &limbs) {
+    FixedBigInt result;
+    result.limbs = limbs;
+    return result;
+  }
+  constexpr const std::array<limb, size> &data() const { return limbs; }
+
+  BigInt toBigInt() const {
+    std::array<limb, size> magnitude = abs(limbs);
+    return BigInt::fromLimbs(
+        std::vector<limb>(magnitude.begin(), magnitude.end()), negative());
+  }
+  operator BigInt() const { return toBigInt(); }
+
+  // Arithmetic Operators
+
+  // Binary Operators
+  constexpr FixedBigInt operator+(const FixedBigInt &other) const {
+    FixedBigInt result;
+    std::uint64_t carry = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+      std::uint64_t sum = std::uint64_t(limbs[i]) + other.limbs[i] + carry;
+      result.limbs[i] = limb(sum);
+      carry = sum >> 32;
+    }
+    return result;
+  }
+  constexpr FixedBigInt operator-(const FixedBigInt &other) const {
+    FixedBigInt result;
+    std::uint64_t borrow = 0;
+    for (std::size_t i = 0; i < size; ++i) {
+      std::uint64_t diff = std::uint64_t(limbs[i]) - other.limbs[i] - borrow;
+      result.limbs[i] = limb(diff);
+      borrow = diff >> 63;
+    }
+    return result;
+  }
+  // The low Bits bits of a product do not depend on the signs, so two's
+  // complement operands multiply directly.
+  constexpr FixedBigInt operator*(const FixedBigInt &other) const {
+    FixedBigInt result;
+    for (std::size_t i = 0; i < size; ++i) {
+      std::uint64_t carry = 0;
+      for (std::size_t j = 0; i + j < size; ++j) {
+        std::uint64_t value = result.limbs[i + j] +
+                              std::uint64_t(limbs[i]) * other.limbs[j] + carry;
+        result.limbs[i + j] = limb(value);
+        carry = value >> 32;
+      }
+    }
+    return result;
+  }
+  // Division rounds toward zero and the remainder takes the sign of the
+  // dividend, as with BigInt.
+  constexpr FixedBigInt operator/(const FixedBigInt &other) const {
+    std::array<limb, size> quotient{}, remainder{};
+    divide(abs(limbs), abs(other.limbs), quotient, remainder);
+    return fromMagnitude(quotient, negative() != other.negative());
+  }
+  constexpr FixedBigInt operator%(const FixedBigInt &other) const {
+    std::array<limb, size> quotient{}, remainder{};
+    divide(abs(limbs), abs(other.limbs), quotient, remainder);
+    return fromMagnitude(remainder, negative());
+  }
+  constexpr FixedBigInt operator+(const long long &other) const {
+    return *this + FixedBigInt(other);
+  }
+  constexpr FixedBigInt operator-(const long long &other) const {
+    return *this - FixedBigInt(other);
+  }
+  constexpr FixedBigInt operator*(const long long &other) const {
+    return *this * FixedBigInt(other);
+  }
+  constexpr FixedBigInt operator/(const long long &other) const {
+    return *this / FixedBigInt(other);
+  }
+  constexpr FixedBigInt operator%(const long long &other) const {
+    return *this % FixedBigInt(other);
+  }
+  FixedBigInt operator+(const std::string &other) const {
+    return *this + FixedBigInt(other);
+  }
+  FixedBigInt operator-(const std::string &other) const {
+    return *this - FixedBigInt(other);
+  }
+  FixedBigInt operator*(const std::string &other) const {
+    return *this * FixedBigInt(other);
+  }
+  FixedBigInt operator/(const std::string &other) const {
+    return *this / FixedBigInt(other);
+  }
+  FixedBigInt operator%(const std::string &other) const {
+    return *this % FixedBigInt(other);
+  }
+
+  // Unary Operators
+  constexpr FixedBigInt operator+() const { return *this; }
+  constexpr FixedBigInt operator-() const { return FixedBigInt() - *this; }
+
+  // Comparison Operators
+  constexpr bool operator==(const FixedBigInt &other) const {
+    for (std::size_t i = 0; i < size; ++i) {
+      if (limbs[i] != other.limbs[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+  constexpr bool operator!=(const FixedBigInt &other) const {
+    return !(*this == other);
+  }
+  constexpr bool operator<(const FixedBigInt &other) const {
+    if (negative() != other.negative()) {
+      return negative();
+    }
+    // Same sign: two's complement orders like the unsigned limbs
+    return lessUnsigned(limbs, other.limbs);
+  }
+  constexpr bool operator>(const FixedBigInt &other) const {
+    return other < *this;
+  }
+  constexpr bool operator<=(const FixedBigInt &other) const {
+    return !(other < *this);
+  }
+  constexpr bool operator>=(const FixedBigInt &other) const {
+    return !(*this < other);
+  }
+  constexpr bool operator==(const long long &other) const {
+    return compareLong(other) == 0;
+  }
+  constexpr bool operator!=(const long long &other) const {
+    return compareLong(other) != 0;
+  }
+  constexpr bool operator<(const long long &other) const {
+    return compareLong(other) < 0;
+  }
+  constexpr bool operator>(const long long &other) const {
+    return compareLong(other) > 0;
+  }
+  constexpr bool operator<=(const long long &other) const {
+    return compareLong(other) <= 0;
+  }
+  constexpr bool operator>=(const long long &other) const {
+    return compareLong(other) >= 0;
+  }
+  bool operator==(const std::string &other) const {
+    return *this == FixedBigInt(other);
+  }
+  bool operator!=(const std::string &other) const {
+    return *this != FixedBigInt(other);
+  }
+  bool operator<(const std::string &other) const {
+    return *this < FixedBigInt(other);
+  }
+  bool operator>(const std::string &other) const {
+    return *this > FixedBigInt(other);
+  }
+  bool operator<=(const std::string &other) const {
+    return *this <= FixedBigInt(other);
+  }
+  bool operator>=(const std::string &other) const {
+    return *this >= FixedBigInt(other);
+  }
+
+  // Assignment Operators
+  constexpr FixedBigInt &operator+=(const FixedBigInt &other) {
+    return *this = *this + other;
+  }
+  constexpr FixedBigInt &operator-=(const FixedBigInt &other) {
+    return *this = *this - other;
+  }
+  constexpr FixedBigInt &operator*=(const FixedBigInt &other) {
+    return *this = *this * other;
+  }
+  constexpr FixedBigInt &operator/=(const FixedBigInt &other) {
+    return *this = *this / other;
+  }
+  constexpr FixedBigInt &operator%=(const FixedBigInt &other) {
+    return *this = *this % other;
+  }
+  constexpr FixedBigInt &operator+=(const long long &other) {
+    return *this = *this + FixedBigInt(other);
+  }
+  constexpr FixedBigInt &operator-=(const long long &other) {
+    return *this = *this - FixedBigInt(other);
+  }
+  constexpr FixedBigInt &operator*=(const long long &other) {
+    return *this = *this * FixedBigInt(other);
+  }
+  constexpr FixedBigInt &operator/=(const long long &other) {
+    return *this = *this / FixedBigInt(other);
+  }
+  constexpr FixedBigInt &operator%=(const long long &other) {
+    return *this = *this % FixedBigInt(other);
+  }
+  FixedBigInt &operator+=(const std::string &other) {
+    return *this = *this + FixedBigInt(other);
+  }
+  FixedBigInt &operator-=(const std::string &other) {
+    return *this = *this - FixedBigInt(other);
+  }
+  FixedBigInt &operator*=(const std::string &other) {
+    return *this = *this * FixedBigInt(other);
+  }
+  FixedBigInt &operator/=(const std::string &other) {
+    return *this = *this / FixedBigInt(other);
+  }
+  FixedBigInt &operator%=(const std::string &other) {
+    return *this = *this % FixedBigInt(other);
+  }
+
+  // Number of decimal digits
+  int length() const {
+    std::string str = toString();
+    return negative() ? str.length() - 1 : str.length();
+  }
+
+  // Conversion Functions
+  std::string toString() const {
+    std::array<limb, size> magnitude = abs(limbs);
+    std::string result;
+    do {
+      limb chunk = divSmall(magnitude, 1000000000);
+      for (int i = 0; i < 9; ++i) {
+        result.push_back('0' + chunk % 10);
+        chunk /= 10;
+      }
+    } while (!isZero(magnitude));
+    while (result.size() > 1 && result.back() == '0') {
+      result.pop_back();
+    }
+    if (negative()) {
+      result.push_back('-');
+    }
+    return std::string(result.rbegin(), result.rend());
+  }
+
+  // I/O Operators
+  friend std::ostream &operator<<(std::ostream &os, const FixedBigInt &num) {
+    os << num.toString();
+    return os;
+  }
+  friend std::istream &operator>>(std::istream &is, FixedBigInt &num) {
+    std::string input;
+    is >> input;
+    num = FixedBigInt(input);
+    return is;
+  }
+
+private:
+  // Two's complement limbs, least significant first
+  std::array<limb, size> limbs;
+
+  constexpr bool negative() const { return limbs[size - 1] >> 31; }
+
+  // Three-way comparison with other as a 64-bit value, so it never throws
+  // when other does not fit in Bits
+  constexpr int compareLong(long long other) const {
+    if constexpr (size == 1) {
+      long long value = static_cast<std::int32_t>(limbs[0]);
+      return value < other ? -1 : value > other;
+    } else {
+      FixedBigInt wide(other);
+      return *this < wide ? -1 : wide < *this;
+    }
+  }
+
+  static constexpr bool isZero(const std::array<limb, size> &a) {
+    for (std::size_t i = 0; i < size; ++i) {
+      if (a[i] != 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Absolute value of a two's complement number as an unsigned magnitude
+  static constexpr std::array<limb, size> abs(const std::array<limb, size> &a) {
+    if (!(a[size - 1] >> 31)) {
+      return a;
+    }
+    return (-fromLimbs(a)).limbs;
+  }
+
+  static constexpr FixedBigInt fromMagnitude(const std::array<limb, size> &a,
+                                             bool negative) {
+    return negative ? -fromLimbs(a) : fromLimbs(a);
+  }
+
+  // a = a * factor + addend, return the limb carried out
+  static constexpr limb mulAdd(std::array<limb, size> &a, limb factor,
+                               limb addend) {
+    std::uint64_t carry = addend;
+    for (std::size_t i = 0; i < size; ++i) {
+      std::uint64_t value = std::uint64_t(a[i]) * factor + carry;
+      a[i] = limb(value);
+      carry = value >> 32;
+    }
+    return limb(carry);
+  }
+
+  // a = a / divisor, return the remainder
+  static constexpr limb divSmall(std::array<limb, size> &a, limb divisor) {
+    std::uint64_t remainder = 0;
+    for (std::size_t i = size; i-- > 0;) {
+      std::uint64_t current = (remainder << 32) | a[i];
+      a[i] = limb(current / divisor);
+      remainder = current % divisor;
+    }
+    return limb(remainder);
+  }
+
+  // Unsigned shift-subtract long division of magnitudes
+  static constexpr void divide(const std::array<limb, size> &a,
+                               const std::array<limb, size> &b,
+                               std::array<limb, size> &quotient,
+                               std::array<limb, size> &remainder) {
+    if (isZero(b)) {
+      throw std::logic_error("Undefined, attempt to divide by zero. Please "
+                             "enter a non-zero divisor.");
+    }
+    for (std::size_t bit = Bits; bit-- > 0;) {
+      // remainder = remainder * 2 + next bit of a
+      limb carry = (a[bit / 32] >> (bit % 32)) & 1;
+      for (std::size_t i = 0; i < size; ++i) {
+        limb next = remainder[i] >> 31;
+        remainder[i] = (remainder[i] << 1) | carry;
+        carry = next;
+      }
+      // The remainder stays below b <= 2^(Bits - 1), so no bit is lost above
+      if (!lessUnsigned(remainder, b)) {
+        std::uint64_t borrow = 0;
+        for (std::size_t i = 0; i < size; ++i) {
+          std::uint64_t diff = std::uint64_t(remainder[i]) - b[i] - borrow;
+          remainder[i] = limb(diff);
+          borrow = diff >> 63;
+        }
+        quotient[bit / 32] |= limb(1) << (bit % 32);
+      }
+    }
+  }
+
+  static constexpr bool lessUnsigned(const std::array<limb, size> &a,
+                                     const std::array<limb, size> &b) {
+    for (std::size_t i = size; i-- > 0;) {
+      if (a[i] != b[i]) {
+        return a[i] < b[i];
+      }
+    }
+    return false;
+  }
+
+  // Negate a parsed magnitude if needed, rejecting magnitudes that fall
+  // outside [-2^(Bits - 1), 2^(Bits - 1) - 1]
+  void setMagnitude(bool negativeValue) {
+    bool topBit = negative();
+    if (topBit) {
+      FixedBigInt minimum;
+      minimum.limbs[size - 1] = limb(1) << 31;
+      if (!negativeValue || *this != minimum) {
+        throw std::overflow_error("Number does not fit in " +
+                                  std::to_string(Bits) + " bits.");
+      }
+    }
+    if (negativeValue) {
+      *this = -*this;
+    }
+  }
+};
+
+// Mixed-width operators widen the narrower operand, so the result has the
+// width of the wider one
+template <std::size_t A, std::size_t B>
+using WiderFixedBigInt =
+    std::enable_if_t<A != B, FixedBigInt<(A > B ? A : B)>>;
+
+template <std::size_t A, std::size_t B>
+constexpr WiderFixedBigInt<A, B> operator+(const FixedBigInt<A> &a,
+                                           const FixedBigInt<B> &b) {
+  return WiderFixedBigInt<A, B>(a) + WiderFixedBigInt<A, B>(b);
+}
+template <std::size_t A, std::size_t B>
+constexpr WiderFixedBigInt<A, B> operator-(const FixedBigInt<A> &a,
+                                           const FixedBigInt<B> &b) {
+  return WiderFixedBigInt<A, B>(a) - WiderFixedBigInt<A, B>(b);
+}
+template <std::size_t A, std::size_t B>
+constexpr WiderFixedBigInt<A, B> operator*(const FixedBigInt<A> &a,
+                                           const FixedBigInt<B> &b) {
+  return WiderFixedBigInt<A, B>(a) * WiderFixedBigInt<A, B>(b);
+}
+template <std::size_t A, std::size_t B>
+constexpr WiderFixedBigInt<A, B> operator/(const FixedBigInt<A> &a,
+                                           const FixedBigInt<B> &b) {
+  return WiderFixedBigInt<A, B>(a) / WiderFixedBigInt<A, B>(b);
+}
+template <std::size_t A, std::size_t B>
+constexpr WiderFixedBigInt<A, B> operator%(const FixedBigInt<A> &a,
+                                           const FixedBigInt<B> &b) {
+  return WiderFixedBigInt<A, B>(a) % WiderFixedBigInt<A, B>(b);
+}
+template <std::size_t A, std::size_t B>
+constexpr std::enable_if_t<A != B, bool> operator==(const FixedBigInt<A> &a,
+                                                    const FixedBigInt<B> &b) {
+  return WiderFixedBigInt<A, B>(a) == WiderFixedBigInt<A, B>(b);
+}
+template <std::size_t A, std::size_t B>
+constexpr std::enable_if_t<A != B, bool> operator!=(const FixedBigInt<A> &a,
+                                                    const FixedBigInt<B> &b) {
+  return WiderFixedBigInt<A, B>(a) != WiderFixedBigInt<A, B>(b);
+}
+template <std::size_t A, std::size_t B>
+constexpr std::enable_if_t<A != B, bool> operator<(const FixedBigInt<A> &a,
+                                                   const FixedBigInt<B> &b) {
+  return WiderFixedBigInt<A, B>(a) < WiderFixedBigInt<A, B>(b);
+}
+template <std::size_t A, std::size_t B>
+constexpr std::enable_if_t<A != B, bool> operator>(const FixedBigInt<A> &a,
+                                                   const FixedBigInt<B> &b) {
+  return WiderFixedBigInt<A, B>(a) > WiderFixedBigInt<A, B>(b);
+}
+template <std::size_t A, std::size_t B>
+constexpr std::enable_if_t<A != B, bool> operator<=(const FixedBigInt<A> &a,
+                                                    const FixedBigInt<B> &b) {
+  return WiderFixedBigInt<A, B>(a) <= WiderFixedBigInt<A, B>(b);
+}
+template <std::size_t A, std::size_t B>
+constexpr std::enable_if_t<A != B, bool> operator>=(const FixedBigInt<A> &a,
+                                                    const FixedBigInt<B> &b) {
+  return WiderFixedBigInt<A, B>(a) >= WiderFixedBigInt<A, B>(b);
+}
+
+// Compile-Time Literals
+
+// Parser behind the _big literal. Chars are the characters of the literal as
+// written, including an optional 0x prefix and ' digit separators.
+template <char... Chars> struct BigIntLiteral {
+  static constexpr char chars[] = {Chars...};
+  static constexpr std::size_t count = sizeof...(Chars);
+  static constexpr bool isHex =
+      count > 2 && chars[0] == '0' && (chars[1] == 'x' || chars[1] == 'X');
+  static constexpr std::size_t start = isHex ? 2 : 0;
+  static constexpr limb base = isHex ? 16 : 10;
+
+  static constexpr int digitValue(char c) {
+    if (c >= '0' && c <= '9') {
+      return c - '0';
+    } else if (isHex && c >= 'a' && c <= 'f') {
+      return c - 'a' + 10;
+    } else if (isHex && c >= 'A' && c <= 'F') {
+      return c - 'A' + 10;
+    }
+    return -1;
+  }
+
+  static constexpr bool valid() {
+    std::size_t digits = 0;
+    for (std::size_t i = start; i < count; ++i) {
+      if (chars[i] == '\'') {
+        continue;
+      }
+      if (digitValue(chars[i]) < 0) {
+        return false;
+      }
+      ++digits;
+    }
+    return digits > 0;
+  }
+
+  static constexpr std::size_t digitCount() {
+    std::size_t digits = 0;
+    for (std::size_t i = start; i < count; ++i) {
+      digits += chars[i] != '\'' ? 1 : 0;
+    }
+    return digits;
+  }
+
+  // A decimal digit needs at most log2(10) < 3.322 bits, plus one sign bit
+  static constexpr std::size_t bits =
+      isHex ? 4 * digitCount() + 1 : digitCount() * 3322 / 1000 + 2;
+  // Literals are at least 512 bits wide, so arithmetic on ordinary constants
+  // has room to grow before it wraps
+  static constexpr std::size_t minimumLimbs = 512 / 32;
+  static constexpr std::size_t limbs =
+      bits / 32 + 1 > minimumLimbs ? bits / 32 + 1 : minimumLimbs;
+
+  static constexpr std::array<limb, limbs> parse() {
+    std::array<limb, limbs> result{};
+    for (std::size_t i = start; i < count; ++i) {
+      if (chars[i] == '\'') {
+        continue;
+      }
+      std::uint64_t carry = digitValue(chars[i]);
+      for (std::size_t j = 0; j < limbs; ++j) {
+        std::uint64_t value = std::uint64_t(result[j]) * base + carry;
+        result[j] = limb(value);
+        carry = value >> 32;
+      }
+    }
+    return result;
+  }
+};
+
+// 123456789012345678901234567890_big is converted to limbs by the compiler and
+// yields a FixedBigInt<512>, or a wider one for literals that need more bits.
+// Literals of different widths combine through the mixed-width operators.
+// Converting one to BigInt still runs toBigInt() at runtime.
+template <char... Chars> constexpr auto operator""_big() {
+  using Literal = BigIntLiteral<Chars...>;
+  static_assert(Literal::valid(),
+                "_big literals must be decimal or hexadecimal integers.");
+  return FixedBigInt<32 * Literal::limbs>::fromLimbs(Literal::parse());
+}
+
+#endif
@@ -1,22 +1,61 @@
 #ifndef BIGINT_H
 #define BIGINT_H
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <deque>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 // Define the digit [0-9] type
 typedef char digit;
 
+// Define the binary limb type used by the fixed-width kernels
+typedef std::uint32_t limb;
+
+template <typename Op, typename L, typename R> class BigIntExpr;
+template <std::size_t Bits> class FixedBigInt;
+
+// Rounding of the quotient in signed division. The remainder always satisfies
+// a = q * b + r.
+enum class DivisionMode {
+  Truncate,  // Round toward zero, r has the sign of a (C++ semantics)
+  Floor,     // Round toward negative infinity, r has the sign of b
+  Ceil,      // Round toward positive infinity, r has the opposite sign of b
+  Euclidean, // r is always non-negative
+};
+
+// Timing behaviour of an operation. Constant runs in time that depends only on
+// the widths of the operands, never on their values.
+enum class Timing { Variable, Constant };
+
+// Enabled for decimal string keys, i.e. types that convert to std::string_view
+// such as std::string and string literals. These convert to BigInt as well, so
+// taking them by template keeps overloads on BigInt and long long unambiguous.
+template <typename T>
+using enableIfString = std::enable_if_t<
+    std::is_convertible<const T &, std::string_view>::value>;
+
 class BigInt {
 public:
   // Constructors
 
   BigInt();
   BigInt(const BigInt &num);
+  // Moving steals the digits and leaves num equal to 0
+  BigInt(BigInt &&num) noexcept;
   BigInt(long long value);
   BigInt(const std::string &str);
-  BigInt(const std::deque<digit> &digits, bool isNegative);
+  BigInt(std::deque<digit> digits, bool isNegative);
 
   // Arithmetic Operators
 
@@ -37,10 +76,54 @@ public:
   BigInt operator%(const long long &other) const;
   BigInt operator%(const std::string &other) const;
 
+  // Fused Operations
+
+  // Quotient and remainder of a / b from a single division
+  static std::pair<BigInt, BigInt>
+  divmod(const BigInt &a, const BigInt &b,
+         DivisionMode mode = DivisionMode::Truncate);
+  // Quotient and remainder of a / b rounded toward zero
+  static std::pair<BigInt, BigInt> tdiv(const BigInt &a, const BigInt &b);
+  // Quotient and remainder of a / b rounded toward negative infinity
+  static std::pair<BigInt, BigInt> fdiv(const BigInt &a, const BigInt &b);
+  // Quotient and remainder of a / b rounded toward positive infinity
+  static std::pair<BigInt, BigInt> cdiv(const BigInt &a, const BigInt &b);
+  // Quotient and non-negative remainder of a / b
+  static std::pair<BigInt, BigInt> ediv(const BigInt &a, const BigInt &b);
+  // acc += a * b without a temporary product
+  static BigInt &addmul(BigInt &acc, const BigInt &a, const BigInt &b);
+  // acc -= a * b without a temporary product
+  static BigInt &submul(BigInt &acc, const BigInt &a, const BigInt &b);
+
+  // (base ^ exponent) mod modulus. The constant-time path requires an odd
+  // modulus and pads the exponent to exponentWidth limbs, or to the width of
+  // the modulus if 0, so its windows do not depend on the exponent; a wider
+  // exponent throws overflow_error. It still leaks the digit counts of base
+  // and exponent through their decimal conversion, and base itself through
+  // its variable-time reduction by ediv.
+  static BigInt powmod(const BigInt &base, const BigInt &exponent,
+                       const BigInt &modulus, Timing timing = Timing::Variable,
+                       std::size_t exponentWidth = 0);
+
   // Unary Operators
   BigInt operator+() const;
   BigInt operator-() const;
 
+  // Three-way comparison: negative if this < other, 0 if equal, positive if
+  // this > other. Decided by sign and length before any digit is read.
+  int compare(const BigInt &other) const;
+  int compare(const long long &other) const;
+  template <typename T, typename = enableIfString<T>>
+  int compare(const T &other) const {
+    return compareString(other);
+  }
+
+  // Hash of the value, mixing 16 digits per 64-bit word. Values that compare
+  // equal hash equal, whatever type they are given as.
+  std::size_t hash(std::uint64_t seed = 0) const;
+  static std::size_t hashOf(const long long &value, std::uint64_t seed = 0);
+  static std::size_t hashOf(std::string_view value, std::uint64_t seed = 0);
+
   // Comparison Operators
   bool operator==(const BigInt &other) const;
   bool operator!=(const BigInt &other) const;
@@ -62,6 +145,8 @@ public:
   bool operator>=(const std::string &other) const;
 
   // Assignment Operators
+  BigInt &operator=(const BigInt &other);
+  BigInt &operator=(BigInt &&other) noexcept;
   BigInt &operator+=(const BigInt &other);
   BigInt &operator-=(const BigInt &other);
   BigInt &operator*=(const BigInt &other);
@@ -83,6 +168,12 @@ public:
 
   // Conversion Functions
   std::string toString() const;
+  // Little-endian binary limbs of the absolute value, zero-padded to width
+  // limbs if width is not 0. Throw overflow_error if the value does not fit.
+  std::vector<limb> toLimbs(std::size_t width = 0) const;
+  // Build a BigInt from little-endian binary limbs
+  static BigInt fromLimbs(const std::vector<limb> &limbs,
+                          bool isNegative = false);
 
   // I/O Operators
   friend std::ostream &operator<<(std::ostream &os, const BigInt &bigInt);
@@ -93,7 +184,152 @@ private:
   std::deque<digit> digits;
   // Sign of the BigInt. True if negative, false otherwise.
   bool isNegative;
+
+  // Write the decimal digits of value to out, most significant first, and
+  // return how many were written. out must hold 20 digits.
+  static int toDigits(unsigned long long value, digit *out);
+  // Split str into its sign and its digits without leading zeros. Throw
+  // invalid_argument if str is not an integer.
+  static bool parseDigits(std::string_view str, std::string_view &magnitude);
+  // Three-way comparison with a decimal string
+  int compareString(std::string_view other) const;
+
+  // Add a * b to this BigInt in place. If negate is true, subtract instead.
+  void accumulate(const BigInt &a, const BigInt &b, bool negate);
+
+  template <typename Op, typename L, typename R> friend class BigIntExpr;
+  friend class BigIntRef;
+  template <std::size_t Bits> friend class FixedBigInt;
+};
+
+// Immutable handle to a BigInt with shared, reference-counted storage. Copies
+// share one BigInt through the atomic count of std::shared_ptr, so fanning a
+// large value out to many threads is O(1). Compound assignments are
+// copy-on-write: a handle that shares its value copies it before changing it,
+// so other handles never observe the change.
+class SharedBigInt {
+public:
+  SharedBigInt() : value(std::make_shared<BigInt>()) {}
+  SharedBigInt(BigInt num) : value(std::make_shared<BigInt>(std::move(num))) {}
+  SharedBigInt(long long num) : value(std::make_shared<BigInt>(num)) {}
+  SharedBigInt(const std::string &str) : value(std::make_shared<BigInt>(str)) {}
+  SharedBigInt(const SharedBigInt &other) = default;
+  // Moving steals the value and leaves other sharing a common 0
+  SharedBigInt(SharedBigInt &&other) noexcept
+      : value(std::move(other.value)) {
+    other.value = zero();
+  }
+
+  SharedBigInt &operator=(const SharedBigInt &other) = default;
+  SharedBigInt &operator=(SharedBigInt &&other) noexcept {
+    if (this != &other) {
+      value = std::move(other.value);
+      other.value = zero();
+    }
+    return *this;
+  }
+
+  const BigInt &get() const { return *value; }
+  const BigInt &operator*() const { return *value; }
+  const BigInt *operator->() const { return value.get(); }
+  operator const BigInt &() const { return *value; }
+
+  // Number of handles sharing this value
+  long useCount() const { return value.use_count(); }
+
+  // Assignment Operators
+  SharedBigInt &operator+=(const BigInt &other) {
+    unshare() += other;
+    return *this;
+  }
+  SharedBigInt &operator-=(const BigInt &other) {
+    unshare() -= other;
+    return *this;
+  }
+  SharedBigInt &operator*=(const BigInt &other) {
+    unshare() *= other;
+    return *this;
+  }
+  SharedBigInt &operator/=(const BigInt &other) {
+    unshare() /= other;
+    return *this;
+  }
+  SharedBigInt &operator%=(const BigInt &other) {
+    unshare() %= other;
+    return *this;
+  }
+
+private:
+  std::shared_ptr<BigInt> value;
+
+  // The 0 shared by moved-from handles. It is never changed in place, since
+  // this copy keeps its count above 1.
+  static const std::shared_ptr<BigInt> &zero() {
+    static const std::shared_ptr<BigInt> shared = std::make_shared<BigInt>();
+    return shared;
+  }
+
+  // A count of 1 means no other handle can reach the value, so it may be
+  // changed in place. Otherwise detach onto a private copy first.
+  BigInt &unshare() {
+    if (value.use_count() != 1) {
+      value = std::make_shared<BigInt>(*value);
+    } else {
+      // use_count() is a relaxed load. Synchronize with the release of the
+      // last other handle so its reads of the value happen before our writes.
+      std::atomic_thread_fence(std::memory_order_acquire);
+    }
+    return *value;
+  }
+};
+
+// Transparent hash, equality and ordering of BigInt keys, which also accept
+// long long and std::string_view keys so lookups need not build a BigInt.
+// Use them as std::map<BigInt, T, BigIntLess>, or with std::unordered_map in
+// C++20 where unordered containers support heterogeneous lookup.
+struct BigIntHash {
+  using is_transparent = void;
+  std::size_t operator()(const BigInt &key) const { return key.hash(); }
+  std::size_t operator()(const long long &key) const {
+    return BigInt::hashOf(key);
+  }
+  template <typename T, typename = enableIfString<T>>
+  std::size_t operator()(const T &key) const {
+    return BigInt::hashOf(key);
+  }
+};
+
+struct BigIntEqual {
+  using is_transparent = void;
+  template <typename T> bool operator()(const BigInt &a, const T &b) const {
+    return a.compare(b) == 0;
+  }
+  template <typename T> bool operator()(const T &a, const BigInt &b) const {
+    return b.compare(a) == 0;
+  }
+  bool operator()(const BigInt &a, const BigInt &b) const {
+    return a.compare(b) == 0;
+  }
+};
+
+struct BigIntLess {
+  using is_transparent = void;
+  template <typename T> bool operator()(const BigInt &a, const T &b) const {
+    return a.compare(b) < 0;
+  }
+  template <typename T> bool operator()(const T &a, const BigInt &b) const {
+    return b.compare(a) > 0;
+  }
+  bool operator()(const BigInt &a, const BigInt &b) const {
+    return a.compare(b) < 0;
+  }
+};
+
+namespace std {
+template <> struct hash<BigInt> {
+  std::size_t operator()(const BigInt &value) const { return value.hash(); }
 };
+} // namespace std
 
 // Utility Functions
 
@@ -105,6 +341,33 @@ std::deque<digit> add(const std::deque<digit> &a, const std::deque<digit> &b,
 std::deque<digit> multiply(const std::deque<digit> &a,
                            const std::deque<digit> &b);
 
+// Signed column accumulator. Digits and digit products of any sign are added
+// into little-endian columns without carrying, and carries are resolved once
+// by resolve(), so a whole sum of terms is built in a single buffer.
+class DigitColumns {
+public:
+  // Reserve columns for a result of up to width digits
+  explicit DigitColumns(std::size_t width);
+
+  // Add a, or subtract it if negative is true
+  void add(const std::deque<digit> &a, bool negative);
+  // Add a * b, or subtract it if negative is true
+  void addProduct(const std::deque<digit> &a, const std::deque<digit> &b,
+                  bool negative);
+  // Carry the columns into the digits of the absolute value of the total and
+  // return true if the total is negative
+  bool resolve(std::deque<digit> &result);
+
+private:
+  std::vector<long long> columns;
+};
+
+// Add a * b to acc in place. If sub is true, subtract a * b from acc instead.
+// Return true if the result went below zero, in which case acc holds its
+// absolute value.
+bool multiplyAccumulate(std::deque<digit> &acc, const std::deque<digit> &a,
+                        const std::deque<digit> &b, const bool &sub = false);
+
 // Divide two deques of digits and return quotient and remainder
 std::pair<std::deque<digit>, std::deque<digit>>
 divideWithRemainder(const std::deque<digit> &a, const std::deque<digit> &b);
@@ -116,4 +379,274 @@ bool greater(const std::deque<digit> &a, const std::deque<digit> &b);
 // Match two deques of digits a.k.a compare absolute values of two BigInts
 bool equal(const std::deque<digit> &a, const std::deque<digit> &b);
 BigInt randomize(const int &size);
+
+// Random Generation
+
+// These take a caller-owned engine such as std::mt19937_64, so a run is
+// reproducible from the engine's seed and no engine is built per call.
+
+// Draw 64 uniformly random bits from gen
+template <typename Engine> std::uint64_t randomWord(Engine &gen) {
+  if constexpr (Engine::min() == 0 &&
+                Engine::max() == std::numeric_limits<std::uint64_t>::max()) {
+    return gen();
+  } else {
+    std::uniform_int_distribution<std::uint64_t> dis;
+    return dis(gen);
+  }
+}
+
+// Fill limbs with random bits, 64 at a time, keeping only the low bits
+template <typename Engine>
+void randomLimbs(Engine &gen, std::vector<limb> &limbs, std::size_t bits) {
+  limbs.assign((bits + 31) / 32, 0);
+  for (std::size_t i = 0; i < limbs.size(); i += 2) {
+    std::uint64_t word = randomWord(gen);
+    limbs[i] = limb(word);
+    if (i + 1 < limbs.size()) {
+      limbs[i + 1] = limb(word >> 32);
+    }
+  }
+  if (bits % 32 != 0) {
+    limbs.back() &= (limb(1) << (bits % 32)) - 1;
+  }
+}
+
+// Generate a uniformly random non-negative BigInt below 2^bits. If exactLength
+// is true, the top bit is set so the result has exactly bits bits.
+template <typename Engine>
+BigInt randomBits(Engine &gen, std::size_t bits, bool exactLength = false) {
+  if (bits == 0) {
+    throw std::invalid_argument("Bit length must be greater than 0.");
+  }
+  std::vector<limb> limbs;
+  randomLimbs(gen, limbs, bits);
+  if (exactLength) {
+    limbs[(bits - 1) / 32] |= limb(1) << ((bits - 1) % 32);
+  }
+  return BigInt::fromLimbs(limbs);
+}
+
+// Generate a uniformly random BigInt in [0, n) by rejection sampling on the
+// bit length of n, which accepts each draw with probability above 1/2.
+template <typename Engine> BigInt randomBelow(Engine &gen, const BigInt &n) {
+  if (n <= 0) {
+    throw std::invalid_argument("Upper bound must be greater than 0.");
+  }
+  std::vector<limb> bound = n.toLimbs();
+  std::size_t bits = bound.size() * 32;
+  for (limb top = bound.back(); (top & (limb(1) << 31)) == 0; top <<= 1) {
+    --bits;
+  }
+  std::vector<limb> limbs;
+  while (true) {
+    randomLimbs(gen, limbs, bits);
+    for (std::size_t i = limbs.size(); i-- > 0;) {
+      if (limbs[i] != bound[i]) {
+        if (limbs[i] < bound[i]) {
+          return BigInt::fromLimbs(limbs);
+        }
+        break;
+      }
+    }
+  }
+}
+
+// Generate a random BigInt with a given number of decimal digits and a random
+// sign. Each 64-bit draw below 18 * 10^18 yields 18 digits at once.
+template <typename Engine> BigInt randomize(Engine &gen, const int &size) {
+  if (size <= 0) {
+    throw std::invalid_argument("Size must be greater than 0.");
+  }
+  const std::uint64_t chunk = 1000000000000000000ULL;
+  std::deque<digit> digits(size);
+  bool isNegative = randomWord(gen) & 1;
+  for (int i = 0; i < size;) {
+    std::uint64_t word = randomWord(gen);
+    if (word >= 18 * chunk) {
+      continue;
+    }
+    word %= chunk;
+    for (int j = 0; j < 18 && i < size; ++j, ++i) {
+      digits[i] = digit(word % 10);
+      word /= 10;
+    }
+  }
+  return BigInt(std::move(digits), isNegative);
+}
+
+// Constant-Time Kernels
+
+// All operands are little-endian limb vectors of the same width. None of these
+// functions branch on or index memory by the values of their operands.
+
+// r = a + b, return the carry out
+limb ctAdd(std::vector<limb> &r, const std::vector<limb> &a,
+           const std::vector<limb> &b);
+
+// r = a - b, return the borrow out
+limb ctSub(std::vector<limb> &r, const std::vector<limb> &a,
+           const std::vector<limb> &b);
+
+// Return 1 if a > b, -1 if a < b and 0 if a = b
+int ctCompare(const std::vector<limb> &a, const std::vector<limb> &b);
+
+// r = choice ? a : b, where choice is 0 or 1
+void ctSelect(std::vector<limb> &r, const std::vector<limb> &a,
+              const std::vector<limb> &b, limb choice);
+
+// r = a * b / 2^(32 * n.size()) mod n, with n odd, a < n, b < n and
+// nInv = -n^-1 mod 2^32
+void montgomeryMultiply(std::vector<limb> &r, const std::vector<limb> &a,
+                        const std::vector<limb> &b, const std::vector<limb> &n,
+                        limb nInv);
+
+// (base ^ exponent) mod modulus with a fixed 4-bit window, for odd modulus > 1
+// and base < modulus of the same width. The exponent may have any width.
+std::vector<limb> ctPowmod(const std::vector<limb> &base,
+                           const std::vector<limb> &exponent,
+                           const std::vector<limb> &modulus);
+
+// Expression Templates
+
+// Opt-in lazy evaluation. Wrap an operand with lazy() to capture the whole
+// expression instead of materializing every intermediate, e.g.
+//   BigInt r = lazy(a) * b + lazy(c) * d - e;
+// On assignment every term of the tree is added into one DigitColumns buffer,
+// sized once from width(), and carries are resolved in a single final pass.
+// Expressions hold references to their operands, so consume them within the
+// same full-expression.
+
+struct ExprAdd {};
+struct ExprSub {};
+struct ExprMul {};
+
+// Evaluate an expression node into a new BigInt
+template <typename E> BigInt evaluateExpr(const E &expr) {
+  DigitColumns columns(expr.width());
+  expr.collect(columns, false);
+  std::deque<digit> digits;
+  bool isNegative = columns.resolve(digits);
+  return BigInt(std::move(digits), isNegative);
+}
+
+// Leaf of an expression: a reference to an existing BigInt
+class BigIntRef {
+public:
+  explicit BigIntRef(const BigInt &value) : value(value) {}
+
+  // Upper bound on the number of digits of the value
+  std::size_t width() const { return value.digits.size(); }
+  // Add (or subtract if negate is true) the value column-wise
+  void collect(DigitColumns &columns, bool negate) const {
+    columns.add(value.digits, value.isNegative != negate);
+  }
+  const BigInt &evaluate() const { return value; }
+  operator BigInt() const { return value; }
+
+private:
+  const BigInt &value;
+};
+
+// Binary node of an expression
+template <typename Op, typename L, typename R> class BigIntExpr {
+public:
+  BigIntExpr(const L &lhs, const R &rhs) : lhs(lhs), rhs(rhs) {}
+
+  std::size_t width() const {
+    if constexpr (std::is_same<Op, ExprMul>::value) {
+      return lhs.width() + rhs.width();
+    } else {
+      return std::max(lhs.width(), rhs.width()) + 1;
+    }
+  }
+  void collect(DigitColumns &columns, bool negate) const {
+    if constexpr (std::is_same<Op, ExprAdd>::value) {
+      lhs.collect(columns, negate);
+      rhs.collect(columns, negate);
+    } else if constexpr (std::is_same<Op, ExprSub>::value) {
+      lhs.collect(columns, negate);
+      rhs.collect(columns, !negate);
+    } else {
+      // Materialize only operands that are not already plain BigInts
+      const BigInt &a = lhs.evaluate();
+      const BigInt &b = rhs.evaluate();
+      columns.addProduct(a.digits, b.digits,
+                         (a.isNegative != b.isNegative) != negate);
+    }
+  }
+  BigInt evaluate() const { return evaluateExpr(*this); }
+  operator BigInt() const { return evaluate(); }
+
+private:
+  // Sub-expressions are held by value, leaves by reference
+  L lhs;
+  R rhs;
+};
+
+// Unary minus node of an expression
+template <typename E> class BigIntNegExpr {
+public:
+  explicit BigIntNegExpr(const E &expr) : expr(expr) {}
+
+  std::size_t width() const { return expr.width(); }
+  void collect(DigitColumns &columns, bool negate) const {
+    expr.collect(columns, !negate);
+  }
+  BigInt evaluate() const { return evaluateExpr(*this); }
+  operator BigInt() const { return evaluate(); }
+
+private:
+  E expr;
+};
+
+template <typename T> struct isBigIntExpr : std::false_type {};
+template <> struct isBigIntExpr<BigIntRef> : std::true_type {};
+template <typename Op, typename L, typename R>
+struct isBigIntExpr<BigIntExpr<Op, L, R>> : std::true_type {};
+template <typename E> struct isBigIntExpr<BigIntNegExpr<E>> : std::true_type {};
+
+// Map an operand to its expression node: BigInts become leaves
+inline BigIntRef toExpr(const BigInt &value) { return BigIntRef(value); }
+template <typename E,
+          typename = std::enable_if_t<isBigIntExpr<E>::value>>
+const E &toExpr(const E &expr) {
+  return expr;
+}
+
+// Enabled when at least one side is an expression and the other is an
+// expression or a BigInt, so plain BigInt arithmetic is left untouched.
+template <typename L, typename R>
+using enableIfExpr = std::enable_if_t<
+    (isBigIntExpr<L>::value || isBigIntExpr<R>::value) &&
+    (isBigIntExpr<L>::value || std::is_same<L, BigInt>::value) &&
+    (isBigIntExpr<R>::value || std::is_same<R, BigInt>::value)>;
+
+template <typename T>
+using exprNode = std::decay_t<decltype(toExpr(std::declval<const T &>()))>;
+
+inline BigIntRef lazy(const BigInt &value) { return BigIntRef(value); }
+
+template <typename L, typename R, typename = enableIfExpr<L, R>>
+BigIntExpr<ExprAdd, exprNode<L>, exprNode<R>> operator+(const L &lhs,
+                                                       const R &rhs) {
+  return {toExpr(lhs), toExpr(rhs)};
+}
+
+template <typename L, typename R, typename = enableIfExpr<L, R>>
+BigIntExpr<ExprSub, exprNode<L>, exprNode<R>> operator-(const L &lhs,
+                                                       const R &rhs) {
+  return {toExpr(lhs), toExpr(rhs)};
+}
+
+template <typename L, typename R, typename = enableIfExpr<L, R>>
+BigIntExpr<ExprMul, exprNode<L>, exprNode<R>> operator*(const L &lhs,
+                                                       const R &rhs) {
+  return {toExpr(lhs), toExpr(rhs)};
+}
+
+template <typename E, typename = std::enable_if_t<isBigIntExpr<E>::value>>
+BigIntNegExpr<E> operator-(const E &expr) {
+  return BigIntNegExpr<E>(expr);
+}
 #endif
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "bigint.hpp"
-#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <utility>
 
 // Default constructor
 BigInt::BigInt() : digits({0}), isNegative(false) {}
@@ -10,65 +11,49 @@ BigInt::BigInt(const BigInt &num) {
   digits = num.digits;
   isNegative = num.isNegative;
 }
+
+// Move constructor
+BigInt::BigInt(BigInt &&num) noexcept
+    : digits(std::move(num.digits)), isNegative(num.isNegative) {
+  num.digits.assign(1, 0);
+  num.isNegative = false;
+}
+
 // Integer to BigInt
 BigInt::BigInt(long long int value) {
-  isNegative = false;
-  if (value == 0) {
-    digits.push_front(digit(0));
-  } else {
-    if (value < 0) {
-      value = -value;
-      isNegative = true;
-    }
-    while (value > 0) {
-      digits.push_front(digit(value % 10));
-      value /= 10;
-    }
-  }
+  isNegative = value < 0;
+  // Negate in unsigned arithmetic so the minimum long long does not overflow
+  unsigned long long magnitude =
+      isNegative ? 0ULL - (unsigned long long)value : value;
+  digit buffer[20];
+  int size = toDigits(magnitude, buffer);
+  digits.assign(buffer, buffer + size);
 }
 
-// Deque of digits and sign to BigInt
-BigInt::BigInt(const std::deque<digit> &digits, bool isNegative)
-    : digits(digits), isNegative(isNegative) {
-  if (digits.size() == 0) {
+// Deque of digits and sign to BigInt. Digits are taken by value so callers
+// handing over a temporary deque move it in instead of copying it.
+BigInt::BigInt(std::deque<digit> digits, bool isNegative)
+    : digits(std::move(digits)), isNegative(isNegative) {
+  if (this->digits.size() == 0) {
     this->digits.push_front(digit(0));
     this->isNegative = false;
   } else {
     while (this->digits.size() > 1 && this->digits.front() == 0) {
       this->digits.pop_front();
     }
+    if (this->digits.size() == 1 && this->digits.front() == 0) {
+      this->isNegative = false;
+    }
   }
 }
 
 // String to BigInt
 BigInt::BigInt(const std::string &str) {
-  if (str.empty()) {
-    throw std::invalid_argument("Invalid input. Now set to default value 0. "
-                                "Please re-check your input.");
-  } else {
-    // Binding the sign and setting the start index to read the digits
-    int start = 0;
-    if (str[0] == '-') {
-      isNegative = true;
-      start = 1;
-    } else if (str[0] == '+') {
-      isNegative = false;
-      start = 1;
-    } else {
-      isNegative = false;
-    }
-    int str_len = str.length();
-    // Check if the input contains non-digit characters. If so, throw an error.
-    for (int i = start; i < str_len; ++i) {
-      if (str[i] < '0' || str[i] > '9') {
-        throw std::invalid_argument(
-            "Your BigInt number contains non-digit characters " +
-            str.substr(i, 1) + " with ASCII value " + std::to_string(str[i]) +
-            ". Now set to default value 0. Please re-check your input.");
-      }
-      if (i != start || str[i] != '0' || str_len == 1) {
-        digits.push_back(digit(str[i] - '0'));
-      }
-    }
+  // Binding the sign and skipping leading zeros. Throws if str has non-digit
+  // characters.
+  std::string_view magnitude;
+  isNegative = parseDigits(str, magnitude);
+  for (char c : magnitude) {
+    digits.push_back(digit(c - '0'));
   }
-}
\ No newline at end of file
+}
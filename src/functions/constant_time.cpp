@@ -0,0 +1,143 @@
+#include "bigint.hpp"
+
+// r = a + b, return the carry out
+limb ctAdd(std::vector<limb> &r, const std::vector<limb> &a,
+           const std::vector<limb> &b) {
+  std::uint64_t carry = 0;
+  std::size_t size = a.size();
+  for (std::size_t i = 0; i < size; ++i) {
+    std::uint64_t sum = std::uint64_t(a[i]) + b[i] + carry;
+    r[i] = limb(sum);
+    carry = sum >> 32;
+  }
+  return limb(carry);
+}
+
+// r = a - b, return the borrow out. A negative difference wraps around, which
+// sets the top bit of the 64-bit intermediate.
+limb ctSub(std::vector<limb> &r, const std::vector<limb> &a,
+           const std::vector<limb> &b) {
+  std::uint64_t borrow = 0;
+  std::size_t size = a.size();
+  for (std::size_t i = 0; i < size; ++i) {
+    std::uint64_t diff = std::uint64_t(a[i]) - b[i] - borrow;
+    r[i] = limb(diff);
+    borrow = diff >> 63;
+  }
+  return limb(borrow);
+}
+
+// Compare every limb and let higher limbs override lower ones through masks
+// instead of returning at the first difference.
+int ctCompare(const std::vector<limb> &a, const std::vector<limb> &b) {
+  limb isGreater = 0;
+  limb isLess = 0;
+  std::size_t size = a.size();
+  for (std::size_t i = 0; i < size; ++i) {
+    limb gt = limb((std::uint64_t(b[i]) - a[i]) >> 63);
+    limb lt = limb((std::uint64_t(a[i]) - b[i]) >> 63);
+    limb eq = 1 ^ (gt | lt);
+    isGreater = gt | (eq & isGreater);
+    isLess = lt | (eq & isLess);
+  }
+  return int(isGreater) - int(isLess);
+}
+
+// r = choice ? a : b
+void ctSelect(std::vector<limb> &r, const std::vector<limb> &a,
+              const std::vector<limb> &b, limb choice) {
+  limb mask = limb(0) - (choice & 1);
+  std::size_t size = r.size();
+  for (std::size_t i = 0; i < size; ++i) {
+    r[i] = (a[i] & mask) | (b[i] & ~mask);
+  }
+}
+
+// Montgomery multiplication, coarsely integrated operand scanning. The result
+// is below 2n before the final step, which always computes t - n and selects.
+void montgomeryMultiply(std::vector<limb> &r, const std::vector<limb> &a,
+                        const std::vector<limb> &b, const std::vector<limb> &n,
+                        limb nInv) {
+  std::size_t size = n.size();
+  std::vector<limb> t(size + 2, 0);
+  for (std::size_t i = 0; i < size; ++i) {
+    std::uint64_t carry = 0;
+    for (std::size_t j = 0; j < size; ++j) {
+      std::uint64_t value = t[j] + std::uint64_t(a[j]) * b[i] + carry;
+      t[j] = limb(value);
+      carry = value >> 32;
+    }
+    std::uint64_t value = t[size] + carry;
+    t[size] = limb(value);
+    t[size + 1] = limb(value >> 32);
+
+    // Add m * n so the lowest limb becomes 0, then shift down one limb
+    limb m = t[0] * nInv;
+    value = t[0] + std::uint64_t(m) * n[0];
+    carry = value >> 32;
+    for (std::size_t j = 1; j < size; ++j) {
+      value = t[j] + std::uint64_t(m) * n[j] + carry;
+      t[j - 1] = limb(value);
+      carry = value >> 32;
+    }
+    value = t[size] + carry;
+    t[size - 1] = limb(value);
+    t[size] = t[size + 1] + limb(value >> 32);
+  }
+  std::vector<limb> low(t.begin(), t.begin() + size);
+  std::vector<limb> reduced(size);
+  limb borrow = ctSub(reduced, low, n);
+  ctSelect(r, reduced, low, t[size] | (borrow ^ 1));
+}
+
+// Fixed 4-bit window exponentiation. Every window does four squarings and one
+// multiplication, and the table entry is read by scanning the whole table.
+std::vector<limb> ctPowmod(const std::vector<limb> &base,
+                           const std::vector<limb> &exponent,
+                           const std::vector<limb> &modulus) {
+  std::size_t size = modulus.size();
+  // nInv = -modulus^-1 mod 2^32 by Newton iteration. n * n = 1 mod 8 for odd
+  // n, and each step doubles the number of correct bits.
+  limb inverse = modulus[0];
+  for (int i = 0; i < 4; ++i) {
+    inverse *= 2 - modulus[0] * inverse;
+  }
+  limb nInv = limb(0) - inverse;
+
+  // R^2 mod n with R = 2^(32 * size), by doubling 1 modulo n 64 * size times
+  std::vector<limb> r2(size, 0), doubled(size), reduced(size);
+  r2[0] = 1;
+  for (std::size_t i = 0; i < 64 * size; ++i) {
+    limb carry = ctAdd(doubled, r2, r2);
+    limb borrow = ctSub(reduced, doubled, modulus);
+    ctSelect(r2, reduced, doubled, carry | (borrow ^ 1));
+  }
+
+  std::vector<limb> one(size, 0);
+  one[0] = 1;
+  std::vector<std::vector<limb>> table(16, std::vector<limb>(size));
+  montgomeryMultiply(table[0], one, r2, modulus, nInv);
+  montgomeryMultiply(table[1], base, r2, modulus, nInv);
+  for (int i = 2; i < 16; ++i) {
+    montgomeryMultiply(table[i], table[i - 1], table[1], modulus, nInv);
+  }
+
+  std::vector<limb> result(table[0]), entry(size);
+  for (std::size_t i = exponent.size() * 8; i-- > 0;) {
+    for (int j = 0; j < 4; ++j) {
+      montgomeryMultiply(result, result, result, modulus, nInv);
+    }
+    limb window = (exponent[i / 8] >> (4 * (i % 8))) & 15;
+    for (limb k = 0; k < 16; ++k) {
+      // All ones when k == window, all zeros otherwise
+      limb mask = limb(0) - (limb((k ^ window) - 1) >> 31);
+      for (std::size_t j = 0; j < size; ++j) {
+        entry[j] = (entry[j] & ~mask) | (table[k][j] & mask);
+      }
+    }
+    montgomeryMultiply(result, result, entry, modulus, nInv);
+  }
+  // Leave the Montgomery domain
+  montgomeryMultiply(result, result, one, modulus, nInv);
+  return result;
+}
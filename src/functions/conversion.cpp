@@ -1,4 +1,6 @@
 #include "bigint.hpp"
+#include <stdexcept>
+#include <string>
 
 // Convert a BigInt to string
 std::string BigInt::toString() const {
@@ -10,4 +12,107 @@ std::string BigInt::toString() const {
     result.push_back(d + '0');
   }
   return result;
-}
\ No newline at end of file
+}
+
+// Convert the absolute value of a BigInt to little-endian binary limbs. Digits
+// are consumed 9 at a time, so each step is one multiply-add by 10^9.
+std::vector<limb> BigInt::toLimbs(std::size_t width) const {
+  std::vector<limb> limbs{0};
+  int size = digits.size();
+  int start = 0;
+  while (start < size) {
+    int chunkSize = start == 0 && size % 9 != 0 ? size % 9 : 9;
+    std::uint64_t multiplier = 1;
+    std::uint64_t carry = 0;
+    for (int i = start; i < start + chunkSize; ++i) {
+      multiplier *= 10;
+      carry = carry * 10 + digits[i];
+    }
+    for (limb &l : limbs) {
+      std::uint64_t value = std::uint64_t(l) * multiplier + carry;
+      l = limb(value);
+      carry = value >> 32;
+    }
+    if (carry > 0) {
+      limbs.push_back(limb(carry));
+    }
+    start += chunkSize;
+  }
+  if (width != 0) {
+    if (limbs.size() > width) {
+      throw std::overflow_error("BigInt does not fit in " +
+                                std::to_string(width) + " limbs.");
+    }
+    limbs.resize(width, 0);
+  }
+  return limbs;
+}
+
+// Convert little-endian binary limbs to a BigInt by repeatedly dividing by 10^9
+BigInt BigInt::fromLimbs(const std::vector<limb> &limbs, bool isNegative) {
+  std::vector<limb> value(limbs);
+  while (!value.empty() && value.back() == 0) {
+    value.pop_back();
+  }
+  std::deque<digit> result;
+  while (!value.empty()) {
+    std::uint64_t remainder = 0;
+    for (int i = value.size() - 1; i >= 0; --i) {
+      std::uint64_t current = (remainder << 32) | value[i];
+      value[i] = limb(current / 1000000000);
+      remainder = current % 1000000000;
+    }
+    while (!value.empty() && value.back() == 0) {
+      value.pop_back();
+    }
+    for (int i = 0; i < 9; ++i) {
+      result.push_front(digit(remainder % 10));
+      remainder /= 10;
+    }
+  }
+  return BigInt(result, isNegative);
+}
+
+// Write the decimal digits of value to out, most significant first
+int BigInt::toDigits(unsigned long long value, digit *out) {
+  digit reversed[20];
+  int size = 0;
+  do {
+    reversed[size++] = digit(value % 10);
+    value /= 10;
+  } while (value > 0);
+  for (int i = 0; i < size; ++i) {
+    out[i] = reversed[size - 1 - i];
+  }
+  return size;
+}
+
+// Split a string into sign and canonical digits, so "-007" gives "7" and "-0"
+// gives a non-negative "0". Return true if the number is negative.
+bool BigInt::parseDigits(std::string_view str, std::string_view &magnitude) {
+  std::size_t start = 0;
+  bool negative = false;
+  if (!str.empty() && (str[0] == '-' || str[0] == '+')) {
+    negative = str[0] == '-';
+    start = 1;
+  }
+  if (str.size() == start) {
+    throw std::invalid_argument("Invalid input. Now set to default value 0. "
+                                "Please re-check your input.");
+  }
+  // Check if the input contains non-digit characters. If so, throw an error.
+  for (std::size_t i = start; i < str.size(); ++i) {
+    if (str[i] < '0' || str[i] > '9') {
+      throw std::invalid_argument(
+          "Your BigInt number contains non-digit characters " +
+          std::string(str.substr(i, 1)) + " with ASCII value " +
+          std::to_string(str[i]) +
+          ". Now set to default value 0. Please re-check your input.");
+    }
+  }
+  while (start < str.size() - 1 && str[start] == '0') {
+    ++start;
+  }
+  magnitude = str.substr(start);
+  return negative && magnitude != "0";
+}
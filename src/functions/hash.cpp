@@ -0,0 +1,74 @@
+#include "bigint.hpp"
+
+// Packs a stream of decimal digits into 64-bit words, 16 digits of 4 bits
+// each, and mixes one whole word at a time into the state
+class DigitHasher {
+public:
+  explicit DigitHasher(std::uint64_t seed) : state(seed ^ 0x9e3779b97f4a7c15) {}
+
+  void push(digit d) {
+    word = (word << 4) | std::uint64_t(d);
+    if (++pending == 16) {
+      mix();
+    }
+  }
+
+  // Fold in the partial last word, the digit count and the sign
+  std::size_t finish(bool isNegative) {
+    if (pending > 0) {
+      mix();
+    }
+    state ^= (count << 1) | (isNegative ? 1 : 0);
+    // MurmurHash3 finalizer
+    state ^= state >> 33;
+    state *= 0xff51afd7ed558ccd;
+    state ^= state >> 33;
+    state *= 0xc4ceb9fe1a85ec53;
+    state ^= state >> 33;
+    return std::size_t(state);
+  }
+
+private:
+  std::uint64_t state;
+  std::uint64_t word = 0;
+  std::uint64_t count = 0;
+  int pending = 0;
+
+  void mix() {
+    state = (state ^ word) * 0x9fb21c651e98df25;
+    state ^= state >> 29;
+    count += pending;
+    word = 0;
+    pending = 0;
+  }
+};
+
+std::size_t BigInt::hash(std::uint64_t seed) const {
+  DigitHasher hasher(seed);
+  for (digit d : digits) {
+    hasher.push(d);
+  }
+  return hasher.finish(isNegative);
+}
+
+std::size_t BigInt::hashOf(const long long &value, std::uint64_t seed) {
+  digit buffer[20];
+  unsigned long long magnitude =
+      value < 0 ? 0ULL - (unsigned long long)value : value;
+  int size = toDigits(magnitude, buffer);
+  DigitHasher hasher(seed);
+  for (int i = 0; i < size; ++i) {
+    hasher.push(buffer[i]);
+  }
+  return hasher.finish(value < 0);
+}
+
+std::size_t BigInt::hashOf(std::string_view value, std::uint64_t seed) {
+  std::string_view magnitude;
+  bool isNegative = parseDigits(value, magnitude);
+  DigitHasher hasher(seed);
+  for (char c : magnitude) {
+    hasher.push(digit(c - '0'));
+  }
+  return hasher.finish(isNegative);
+}
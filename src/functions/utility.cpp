@@ -1,7 +1,9 @@
 #include "bigint.hpp"
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <random>
+#include <vector>
 
 // Return length of BigInt
 int BigInt::length() const { return digits.size(); }
@@ -103,6 +105,89 @@ std::deque<digit> multiply(const std::deque<digit> &a,
   return result;
 }
 
+DigitColumns::DigitColumns(std::size_t width) : columns(width + 1, 0) {}
+
+// Add the digits of a to the columns, lowest digit first
+void DigitColumns::add(const std::deque<digit> &a, bool negative) {
+  std::size_t aSize = a.size();
+  if (aSize > columns.size()) {
+    columns.resize(aSize, 0);
+  }
+  const long long sign = negative ? -1 : 1;
+  for (std::size_t i = 0; i < aSize; ++i) {
+    columns[i] += sign * a[aSize - 1 - i];
+  }
+}
+
+// Add every digit product a[i] * b[j] to column i + j. A column holds at most
+// 81 * min(aSize, bSize) per product, far from the range of long long.
+void DigitColumns::addProduct(const std::deque<digit> &a,
+                              const std::deque<digit> &b, bool negative) {
+  std::size_t aSize = a.size();
+  std::size_t bSize = b.size();
+  if (aSize + bSize > columns.size()) {
+    columns.resize(aSize + bSize, 0);
+  }
+  const long long sign = negative ? -1 : 1;
+  for (std::size_t i = 0; i < aSize; ++i) {
+    long long x = sign * a[aSize - 1 - i];
+    if (x == 0) {
+      continue;
+    }
+    for (std::size_t j = 0; j < bSize; ++j) {
+      columns[i + j] += x * b[bSize - 1 - j];
+    }
+  }
+}
+
+// Resolve carries, flooring so every column ends up in [0, 9]. Columns are
+// appended until the carry settles at 0 or -1, and -1 means the columns hold
+// 10^size - |total|, so the ten's complement gives the absolute value back.
+bool DigitColumns::resolve(std::deque<digit> &result) {
+  long long carry = 0;
+  for (std::size_t i = 0; i < columns.size() || (carry != 0 && carry != -1);
+       ++i) {
+    if (i == columns.size()) {
+      columns.push_back(0);
+    }
+    long long value = columns[i] + carry;
+    carry = value / 10;
+    value %= 10;
+    if (value < 0) {
+      value += 10;
+      --carry;
+    }
+    columns[i] = value;
+  }
+  bool negative = carry < 0;
+  if (negative) {
+    int borrow = 0;
+    for (long long &column : columns) {
+      long long value = -column - borrow;
+      borrow = value < 0 ? 1 : 0;
+      column = value + borrow * 10;
+    }
+  }
+  std::size_t size = columns.size();
+  while (size > 1 && columns[size - 1] == 0) {
+    --size;
+  }
+  result.assign(size, 0);
+  for (std::size_t i = 0; i < size; ++i) {
+    result[i] = digit(columns[size - 1 - i]);
+  }
+  return negative;
+}
+
+// Add (or subtract if sub is true) a * b to acc in place
+bool multiplyAccumulate(std::deque<digit> &acc, const std::deque<digit> &a,
+                        const std::deque<digit> &b, const bool &sub) {
+  DigitColumns columns(std::max(acc.size(), a.size() + b.size()));
+  columns.add(acc, false);
+  columns.addProduct(a, b, sub);
+  return columns.resolve(acc);
+}
+
 // Divide two deques of digits
 std::pair<std::deque<digit>, std::deque<digit>>
 divideWithRemainder(const std::deque<digit> &a, const std::deque<digit> &b) {
@@ -138,6 +223,13 @@ divideWithRemainder(const std::deque<digit> &a, const std::deque<digit> &b) {
     quotient = std::deque<digit>{0};
   } else {
 
+    // Multiples 0 * b to 9 * b, built once so that each quotient digit costs
+    // comparisons and a single subtraction
+    std::vector<std::deque<digit>> multiples(10, std::deque<digit>{0});
+    for (int x = 1; x < 10; ++x) {
+      multiples[x] = add(multiples[x - 1], b);
+    }
+
     // Set flag to keep track of the current index of a
     int flag = bSize - 1;
     remainder.erase(remainder.begin() + bSize, remainder.end());
@@ -158,17 +250,27 @@ divideWithRemainder(const std::deque<digit> &a, const std::deque<digit> &b) {
         // temp.back() / b.back()] . Otherwise, guess x in [1, 9]
         digit x =
             remainder.size() == b.size() ? remainder.front() / b.front() : 9;
-        while (greater(multiply(b, std::deque<digit>{x}), remainder)) {
+        while (greater(multiples[x], remainder)) {
           --x;
         }
         // Add x to quotient and subtract b * x from remainder
         quotient.push_back(x);
-        remainder = add(remainder, multiply(b, std::deque<digit>{x}), true);
+        remainder = add(remainder, multiples[x], true);
+      } else {
+        quotient.push_back(0);
       }
       if (i < aSize - 1) {
-        remainder.push_back(a.at(i + 1));
+        // Bring down the next digit without leaving a leading zero behind
+        if (remainder.size() == 1 && remainder.front() == 0) {
+          remainder.front() = a.at(i + 1);
+        } else {
+          remainder.push_back(a.at(i + 1));
+        }
       }
     }
+    while (quotient.size() > 1 && quotient.front() == 0) {
+      quotient.pop_front();
+    }
   }
   return std::make_pair(quotient, remainder);
 }
@@ -182,7 +284,7 @@ bool greater(const std::deque<digit> &a, const std::deque<digit> &b) {
   } else if (aSize < bSize) {
     return false;
   } else {
-    bool isGreater = true;
+    bool isGreater = false;
     for (int i = 0; i < aSize; ++i) {
       if (a.at(i) != b.at(i)) {
         isGreater = a.at(i) > b.at(i);
@@ -207,19 +309,10 @@ bool equal(const std::deque<digit> &a, const std::deque<digit> &b) {
   return true;
 }
 
-// Generate a random BigInt with a given size
+// Generate a random BigInt with a given size, from an engine seeded once per
+// thread by the clock
 BigInt randomize(const int &size) {
-  if (size <= 0) {
-    throw std::invalid_argument("Size must be greater than 0.");
-  }
-  std::mt19937 gen(std::chrono::steady_clock::now().time_since_epoch().count());
-  std::uniform_int_distribution<int> dis(0, 9);
-  std::uniform_int_distribution<int> sign(0, 1);
-  std::deque<char> digits;
-  bool isNegative = bool(sign(gen));
-  for (int i = 0; i < size; ++i) {
-    digits.push_back(dis(gen));
-  }
-
-  return BigInt(digits, isNegative);
-}
\ No newline at end of file
+  thread_local std::mt19937_64 gen(
+      std::chrono::steady_clock::now().time_since_epoch().count());
+  return randomize(gen, size);
+}
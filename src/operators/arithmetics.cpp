@@ -1,4 +1,5 @@
 #include "bigint.hpp"
+#include <stdexcept>
 
 BigInt BigInt::operator+(const BigInt &other) const {
   BigInt result;
@@ -15,7 +16,8 @@ BigInt BigInt::operator+(const BigInt &other) const {
       result.isNegative = other.isNegative;
     }
   }
-  return result;
+  return result.digits.size() == 1 && result.digits.front() == 0 ? BigInt(0)
+                                                                 : result;
 }
 
 BigInt BigInt::operator-(const BigInt &other) const {
@@ -52,12 +54,128 @@ BigInt BigInt::operator/(const BigInt &other) const {
              : BigInt(result, isNegative == other.isNegative ? false : true);
 }
 
+// The remainder takes the sign of the dividend, as with built-in integers
 BigInt BigInt::operator%(const BigInt &other) const {
   std::deque<digit> result =
       divideWithRemainder(this->digits, other.digits).second;
-  return result.size() == 1 && result.front() == 0
-             ? BigInt(0)
-             : BigInt(result, isNegative == other.isNegative ? false : true);
+  return BigInt(result, isNegative);
+}
+
+// Add (or subtract if negate is true) a * b to this BigInt in place
+void BigInt::accumulate(const BigInt &a, const BigInt &b, bool negate) {
+  bool productNegative = (a.isNegative != b.isNegative) != negate;
+  // Same signs add magnitudes, different signs subtract them
+  if (multiplyAccumulate(digits, a.digits, b.digits,
+                         productNegative != isNegative)) {
+    isNegative = !isNegative;
+  }
+  if (digits.size() == 1 && digits.front() == 0) {
+    isNegative = false;
+  }
+}
+
+std::pair<BigInt, BigInt> BigInt::divmod(const BigInt &a, const BigInt &b,
+                                         DivisionMode mode) {
+  std::pair<std::deque<digit>, std::deque<digit>> result =
+      divideWithRemainder(a.digits, b.digits);
+  bool quotientNegative = a.isNegative == b.isNegative ? false : true;
+  bool remainderNegative = a.isNegative;
+  bool exact = result.second.size() == 1 && result.second.front() == 0;
+  // Round the quotient away from zero instead of toward it
+  bool roundUp = false;
+  if (!exact) {
+    switch (mode) {
+    case DivisionMode::Truncate:
+      break;
+    case DivisionMode::Floor:
+      roundUp = quotientNegative;
+      break;
+    case DivisionMode::Ceil:
+      roundUp = !quotientNegative;
+      break;
+    case DivisionMode::Euclidean:
+      roundUp = a.isNegative;
+      break;
+    }
+  }
+  // Moving the quotient one step away from zero moves the remainder by |b|
+  // toward the other sign: |r| becomes |b| - |r|.
+  if (roundUp) {
+    result.first = add(result.first, std::deque<digit>{1});
+    result.second = add(b.digits, result.second, true);
+    remainderNegative = !remainderNegative;
+  }
+  return std::make_pair(BigInt(result.first, quotientNegative),
+                        BigInt(result.second, remainderNegative));
+}
+
+std::pair<BigInt, BigInt> BigInt::tdiv(const BigInt &a, const BigInt &b) {
+  return divmod(a, b, DivisionMode::Truncate);
+}
+
+std::pair<BigInt, BigInt> BigInt::fdiv(const BigInt &a, const BigInt &b) {
+  return divmod(a, b, DivisionMode::Floor);
+}
+
+std::pair<BigInt, BigInt> BigInt::cdiv(const BigInt &a, const BigInt &b) {
+  return divmod(a, b, DivisionMode::Ceil);
+}
+
+std::pair<BigInt, BigInt> BigInt::ediv(const BigInt &a, const BigInt &b) {
+  return divmod(a, b, DivisionMode::Euclidean);
+}
+
+BigInt &BigInt::addmul(BigInt &acc, const BigInt &a, const BigInt &b) {
+  acc.accumulate(a, b, false);
+  return acc;
+}
+
+BigInt &BigInt::submul(BigInt &acc, const BigInt &a, const BigInt &b) {
+  acc.accumulate(a, b, true);
+  return acc;
+}
+
+BigInt BigInt::powmod(const BigInt &base, const BigInt &exponent,
+                      const BigInt &modulus, Timing timing,
+                      std::size_t exponentWidth) {
+  if (modulus.digits.size() == 1 && modulus.digits.front() == 0) {
+    throw std::logic_error("Undefined, attempt to reduce modulo zero. Please "
+                           "enter a non-zero modulus.");
+  }
+  if (modulus.isNegative || exponent.isNegative) {
+    throw std::invalid_argument(
+        "Modulus and exponent of powmod must not be negative.");
+  }
+  if (modulus.digits.size() == 1 && modulus.digits.front() == 1) {
+    return BigInt(0);
+  }
+  // Base reduction uses the variable-time division, so secret bases should
+  // already be below the modulus.
+  BigInt reducedBase = ediv(base, modulus).second;
+
+  if (timing == Timing::Constant) {
+    if (modulus.digits.back() % 2 == 0) {
+      throw std::invalid_argument(
+          "Constant-time powmod requires an odd modulus.");
+    }
+    std::vector<limb> modulusLimbs = modulus.toLimbs();
+    // Pad the exponent to a public width, since the window count follows it
+    std::vector<limb> exponentLimbs = exponent.toLimbs(
+        exponentWidth != 0 ? exponentWidth : modulusLimbs.size());
+    return fromLimbs(ctPowmod(reducedBase.toLimbs(modulusLimbs.size()),
+                              exponentLimbs, modulusLimbs));
+  }
+
+  // Left-to-right square and multiply
+  std::vector<limb> exponentLimbs = exponent.toLimbs();
+  BigInt result(1);
+  for (int i = exponentLimbs.size() * 32 - 1; i >= 0; --i) {
+    result = (result * result) % modulus;
+    if ((exponentLimbs[i / 32] >> (i % 32)) & 1) {
+      result = (result * reducedBase) % modulus;
+    }
+  }
+  return result;
 }
 
 BigInt BigInt::operator+(const long long &other) const {
@@ -1,4 +1,22 @@
 #include "bigint.hpp"
+#include <utility>
+
+BigInt &BigInt::operator=(const BigInt &other) {
+  digits = other.digits;
+  isNegative = other.isNegative;
+  return *this;
+}
+
+// By-value results of the arithmetic operators are moved in, not copied
+BigInt &BigInt::operator=(BigInt &&other) noexcept {
+  if (this != &other) {
+    digits = std::move(other.digits);
+    isNegative = other.isNegative;
+    other.digits.assign(1, 0);
+    other.isNegative = false;
+  }
+  return *this;
+}
 
 BigInt &BigInt::operator+=(const BigInt &other) {
   *this = *this + other;
@@ -59,3 +77,18 @@ BigInt &BigInt::operator/=(const std::string &other) {
   *this = *this / BigInt(other);
   return *this;
 }
+
+BigInt &BigInt::operator%=(const BigInt &other) {
+  *this = *this % other;
+  return *this;
+}
+
+BigInt &BigInt::operator%=(const long long &other) {
+  *this = *this % BigInt(other);
+  return *this;
+}
+
+BigInt &BigInt::operator%=(const std::string &other) {
+  *this = *this % BigInt(other);
+  return *this;
+}
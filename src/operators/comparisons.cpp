@@ -1,5 +1,63 @@
 #include "bigint.hpp"
 
+// Compare two digit sequences of the same sign, most significant first
+template <typename A, typename B>
+static int compareMagnitude(const A &a, int aSize, const B &b, int bSize) {
+  if (aSize != bSize) {
+    return aSize < bSize ? -1 : 1;
+  }
+  for (int i = 0; i < aSize; ++i) {
+    if (a[i] != b[i]) {
+      return a[i] < b[i] ? -1 : 1;
+    }
+  }
+  return 0;
+}
+
+int BigInt::compare(const BigInt &other) const {
+  if (isNegative != other.isNegative) {
+    return isNegative ? -1 : 1;
+  }
+  int result = compareMagnitude(digits, digits.size(), other.digits,
+                                other.digits.size());
+  // Larger magnitudes are smaller among negative numbers
+  return isNegative ? -result : result;
+}
+
+int BigInt::compare(const long long &other) const {
+  bool otherNegative = other < 0;
+  if (isNegative != otherNegative) {
+    return isNegative ? -1 : 1;
+  }
+  digit otherDigits[20];
+  unsigned long long magnitude =
+      otherNegative ? 0ULL - (unsigned long long)other : other;
+  int otherSize = toDigits(magnitude, otherDigits);
+  int result = compareMagnitude(digits, digits.size(), otherDigits, otherSize);
+  return isNegative ? -result : result;
+}
+
+int BigInt::compareString(std::string_view other) const {
+  std::string_view magnitude;
+  bool otherNegative = parseDigits(other, magnitude);
+  if (isNegative != otherNegative) {
+    return isNegative ? -1 : 1;
+  }
+  int result = 0;
+  int size = digits.size();
+  int otherSize = magnitude.size();
+  if (size != otherSize) {
+    result = size < otherSize ? -1 : 1;
+  } else {
+    for (int i = 0; i < size && result == 0; ++i) {
+      if (digits[i] != magnitude[i] - '0') {
+        result = digits[i] < magnitude[i] - '0' ? -1 : 1;
+      }
+    }
+  }
+  return isNegative ? -result : result;
+}
+
 bool BigInt::operator==(const BigInt &other) const {
   if (digits.size() != other.digits.size() || isNegative != other.isNegative) {
     return false;
@@ -17,73 +75,65 @@ bool BigInt::operator==(const BigInt &other) const {
 bool BigInt::operator!=(const BigInt &other) const { return !(*this == other); }
 
 bool BigInt::operator<(const BigInt &other) const {
-  if (isNegative && !other.isNegative) {
-    return true;
-  } else if (!isNegative && other.isNegative) {
-    return false;
-  } else if (digits.size() != other.digits.size()) {
-    return digits.size() < other.digits.size();
-  }
-
-  for (size_t i = 0; i < digits.size(); ++i) {
-    if (digits[i] != other.digits[i]) {
-      return digits[i] < other.digits[i];
-    }
-  }
-
-  return false;
+  return compare(other) < 0;
 }
 
-bool BigInt::operator>(const BigInt &other) const { return other < *this; }
+bool BigInt::operator>(const BigInt &other) const {
+  return compare(other) > 0;
+}
 
-bool BigInt::operator<=(const BigInt &other) const { return !(*this > other); }
+bool BigInt::operator<=(const BigInt &other) const {
+  return compare(other) <= 0;
+}
 
-bool BigInt::operator>=(const BigInt &other) const { return !(*this < other); }
+bool BigInt::operator>=(const BigInt &other) const {
+  return compare(other) >= 0;
+}
 
 bool BigInt::operator==(const long long &other) const {
-  return *this == BigInt(other);
+  return compare(other) == 0;
 }
 
 bool BigInt::operator!=(const long long &other) const {
-  return !(*this == BigInt(other));
+  return compare(other) != 0;
 }
 
 bool BigInt::operator<(const long long &other) const {
-  return *this < BigInt(other);
+  return compare(other) < 0;
 }
 
 bool BigInt::operator>(const long long &other) const {
-  return *this > BigInt(other);
+  return compare(other) > 0;
 }
 
 bool BigInt::operator<=(const long long &other) const {
-  return *this <= BigInt(other);
+  return compare(other) <= 0;
 }
 
 bool BigInt::operator>=(const long long &other) const {
-  return *this >= BigInt(other);
+  return compare(other) >= 0;
 }
 
 bool BigInt::operator==(const std::string &other) const {
-  return *this == BigInt(other);
+  return compare(other) == 0;
 }
 
 bool BigInt::operator!=(const std::string &other) const {
-  return !(*this == BigInt(other));
+  return compare(other) != 0;
 }
 
 bool BigInt::operator<(const std::string &other) const {
-  return *this < BigInt(other);
+  return compare(other) < 0;
 }
 
 bool BigInt::operator>(const std::string &other) const {
-  return *this > BigInt(other);
+  return compare(other) > 0;
 }
 
 bool BigInt::operator<=(const std::string &other) const {
-  return *this <= BigInt(other);
+  return compare(other) <= 0;
 }
 
 bool BigInt::operator>=(const std::string &other) const {
-  return *this >= BigInt(other);
+  return compare(other) >= 0;
 }
@@ -4,6 +4,9 @@ BigInt BigInt::operator+() const { return *this; }
 
 BigInt BigInt::operator-() const {
   BigInt result = *this;
-  result.isNegative = !result.isNegative;
+  // Zero has no sign
+  if (!(digits.size() == 1 && digits.front() == 0)) {
+    result.isNegative = !result.isNegative;
+  }
   return result;
 }
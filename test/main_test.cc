@@ -1,5 +1,9 @@
+#include "fixed_bigint.hpp"
 #include "sample_library.hpp"
 #include <gtest/gtest.h>
+#include <map>
+#include <thread>
+#include <unordered_map>
 
 TEST(NumberIntegrity, PosStr) {
   BigInt b("987654321098765432109876543210");
@@ -25,4 +29,271 @@ TEST(Invalidate, Empty) { EXPECT_THROW(BigInt(""), std::invalid_argument); }
 
 TEST(Invalidate, InvalidChar) {
   EXPECT_THROW(BigInt("123456 7890a"), std::invalid_argument);
-}
\ No newline at end of file
+}
+
+TEST(LazyExpression, FusedSumOfProducts) {
+  BigInt a("123456789012345678901234567890");
+  BigInt b("-98765432109876543210");
+  BigInt c("55555555555555555555");
+  BigInt d("77777777777");
+  BigInt e("-1000000000000000000000000000000000000000000000000000");
+  BigInt r = lazy(a) * b + lazy(c) * d - e;
+  EXPECT_EQ(r, a * b + c * d - e);
+  EXPECT_EQ(BigInt(-(lazy(a) - b)), b - a);
+}
+
+TEST(LazyExpression, AliasedDestination) {
+  BigInt a(12345), b(-678);
+  a = lazy(a) * a - lazy(b) * b;
+  EXPECT_EQ(a.toString(), "151939341");
+}
+
+TEST(FusedOperations, DivMod) {
+  BigInt a("-98765432109876543210"), b("12345");
+  std::pair<BigInt, BigInt> qr = BigInt::divmod(a, b);
+  EXPECT_EQ(qr.first, a / b);
+  EXPECT_EQ(qr.second, a % b);
+  EXPECT_THROW(BigInt::divmod(a, BigInt(0)), std::logic_error);
+}
+
+TEST(FusedOperations, AddMulSubMul) {
+  BigInt acc("1000000000000000000000");
+  BigInt a("-123456789"), b("987654321");
+  BigInt::addmul(acc, a, b);
+  EXPECT_EQ(acc, BigInt("1000000000000000000000") + a * b);
+  BigInt::submul(acc, a, b);
+  EXPECT_EQ(acc.toString(), "1000000000000000000000");
+  BigInt::submul(acc, acc, BigInt(1));
+  EXPECT_EQ(acc.toString(), "0");
+}
+
+TEST(DivisionModes, SignedSemantics) {
+  for (long long a = -13; a <= 13; ++a) {
+    for (long long b = -5; b <= 5; ++b) {
+      if (b == 0) {
+        continue;
+      }
+      long long tq = a / b, tr = a % b;
+      long long fq = tq - (tr != 0 && (tr < 0) != (b < 0));
+      long long cq = tq + (tr != 0 && (tr < 0) == (b < 0));
+      long long eq = tr < 0 ? (b > 0 ? tq - 1 : tq + 1) : tq;
+      std::pair<BigInt, BigInt> t = BigInt::tdiv(a, b);
+      std::pair<BigInt, BigInt> f = BigInt::fdiv(a, b);
+      std::pair<BigInt, BigInt> c = BigInt::cdiv(a, b);
+      std::pair<BigInt, BigInt> e = BigInt::ediv(a, b);
+      EXPECT_EQ(t.first, tq);
+      EXPECT_EQ(t.second, tr);
+      EXPECT_EQ(f.first, fq);
+      EXPECT_EQ(f.second, a - fq * b);
+      EXPECT_EQ(c.first, cq);
+      EXPECT_EQ(c.second, a - cq * b);
+      EXPECT_EQ(e.first, eq);
+      EXPECT_EQ(e.second, a - eq * b);
+      EXPECT_EQ(BigInt(a) % BigInt(b), tr);
+    }
+  }
+}
+
+TEST(ConstantTime, LimbConversion) {
+  BigInt a("-340282366920938463463374607431768211457");
+  std::vector<limb> limbs = a.toLimbs(6);
+  EXPECT_EQ(limbs, (std::vector<limb>{1, 0, 0, 0, 1, 0}));
+  EXPECT_EQ(BigInt::fromLimbs(limbs, true), a);
+  EXPECT_THROW(a.toLimbs(4), std::overflow_error);
+}
+
+TEST(ConstantTime, Kernels) {
+  std::vector<limb> a{0xffffffff, 1}, b{1, 1}, r(2);
+  EXPECT_EQ(ctCompare(a, b), 1);
+  EXPECT_EQ(ctCompare(b, a), -1);
+  EXPECT_EQ(ctCompare(a, a), 0);
+  EXPECT_EQ(ctAdd(r, a, b), 0u);
+  EXPECT_EQ(r, (std::vector<limb>{0, 3}));
+  EXPECT_EQ(ctSub(r, b, a), 1u);
+  ctSelect(r, a, b, 1);
+  EXPECT_EQ(r, a);
+}
+
+TEST(ConstantTime, PowmodMatchesVariableTime) {
+  EXPECT_EQ(BigInt::powmod(4, 13, 497, Timing::Constant), 445);
+  EXPECT_EQ(BigInt::powmod(-4, 13, 497), 52);
+  BigInt base("123456789012345678901234567890123456789");
+  BigInt exponent("98765432109876543210987654321");
+  BigInt modulus("170141183460469231731687303715884105727");
+  EXPECT_EQ(BigInt::powmod(base, exponent, modulus, Timing::Constant),
+            BigInt::powmod(base, exponent, modulus));
+  EXPECT_THROW(BigInt::powmod(base, exponent, 1000, Timing::Constant),
+               std::invalid_argument);
+  EXPECT_EQ(BigInt::powmod(base, 3, modulus, Timing::Constant, 8),
+            BigInt::powmod(base, 3, modulus));
+  EXPECT_THROW(BigInt::powmod(base, modulus * modulus, modulus,
+                              Timing::Constant),
+               std::overflow_error);
+}
+
+TEST(FixedWidth, MatchesBigInt) {
+  BigInt a("-1234567890123456789012345678901234567890");
+  BigInt b("98765432109876543210987");
+  FixedBigInt<256> fa(a), fb(b);
+  EXPECT_EQ((fa + fb).toBigInt(), a + b);
+  EXPECT_EQ((fa - fb).toBigInt(), a - b);
+  EXPECT_EQ((fa * 1000).toString(), (a * 1000).toString());
+  EXPECT_EQ((fa / fb).toBigInt(), a / b);
+  EXPECT_EQ((fa % fb).toBigInt(), a % b);
+  EXPECT_TRUE(fa < fb);
+  EXPECT_TRUE(fa < -fb);
+  EXPECT_EQ(fa.length(), a.length());
+}
+
+TEST(FixedWidth, Limits) {
+  constexpr FixedBigInt<64> max(9223372036854775807LL);
+  static_assert(max + 1 < max, "addition wraps around");
+  static_assert(max * max == 1, "multiplication wraps around");
+  EXPECT_EQ(FixedBigInt<64>("-9223372036854775808") - 1, max);
+  EXPECT_THROW(FixedBigInt<64>("9223372036854775808"), std::overflow_error);
+  EXPECT_THROW(FixedBigInt<64>(BigInt("18446744073709551616")),
+               std::overflow_error);
+  EXPECT_THROW(max / 0, std::logic_error);
+  EXPECT_EQ(FixedBigInt<32>(-2147483648LL).toString(), "-2147483648");
+  EXPECT_THROW(FixedBigInt<32>(2147483648LL), std::overflow_error);
+  EXPECT_FALSE(FixedBigInt<32>(5) == 5000000000LL);
+  EXPECT_TRUE(FixedBigInt<32>(-5) > -5000000000LL);
+  EXPECT_TRUE(FixedBigInt<32>(-5) <= -5LL);
+  EXPECT_THROW(FixedBigInt<64>("-"), std::invalid_argument);
+  EXPECT_THROW(FixedBigInt<64>("+"), std::invalid_argument);
+}
+
+TEST(Literals, ParsedAtCompileTime) {
+  constexpr auto big = 123456789012345678901234567890_big;
+  static_assert(big % 1000000007 == 197434842, "literal is a constant");
+  static_assert(0xffff'ffff'ffff_big == 281474976710655LL, "hex literal");
+  EXPECT_EQ(BigInt(big), BigInt("123456789012345678901234567890"));
+  EXPECT_EQ(BigInt(-big), BigInt("-123456789012345678901234567890"));
+  EXPECT_EQ((1'000_big * 1'000_big).toString(), "1000000");
+  static_assert(100000_big * 100000_big == 10000000000LL, "no 32-bit wrap");
+  constexpr FixedBigInt<1024> wide = FixedBigInt<1024>(1) * 1'000'000'000;
+  static_assert(99999_big + wide - wide == 99999, "mixed widths combine");
+  static_assert(-1_big < wide && wide > 1_big, "mixed-width comparison");
+}
+
+TEST(Random, Reproducible) {
+  std::mt19937_64 first(42), second(42);
+  EXPECT_EQ(randomize(first, 100), randomize(second, 100));
+  EXPECT_EQ(randomBits(first, 300), randomBits(second, 300));
+  EXPECT_LE(randomize(first, 100).length(), 100);
+}
+
+TEST(Random, Ranges) {
+  std::mt19937 gen(7);
+  BigInt bound("1000000000000000000000000000001");
+  for (int i = 0; i < 100; ++i) {
+    BigInt below = randomBelow(gen, bound);
+    EXPECT_TRUE(below >= 0 && below < bound);
+    BigInt exact = randomBits(gen, 70, true);
+    EXPECT_TRUE(exact >= BigInt("590295810358705651712") &&
+                exact < BigInt("1180591620717411303424"));
+  }
+  EXPECT_THROW(randomBelow(gen, BigInt(0)), std::invalid_argument);
+}
+
+TEST(Comparison, AllSigns) {
+  BigInt values[] = {BigInt("-1000"), BigInt(-999), BigInt(-1), BigInt("-0"),
+                     BigInt(1), BigInt("999"), BigInt(1000)};
+  for (int i = 0; i < 7; ++i) {
+    for (int j = 0; j < 7; ++j) {
+      EXPECT_EQ(values[i] < values[j], i < j);
+      EXPECT_EQ(values[i] >= values[j], i >= j);
+      EXPECT_EQ(values[i].compare(values[j]) == 0, i == j);
+    }
+  }
+  EXPECT_EQ(BigInt("-007"), BigInt(-7));
+  EXPECT_EQ(-BigInt(0), BigInt(0));
+  EXPECT_EQ(BigInt(-9223372036854775807LL - 1).toString(),
+            "-9223372036854775808");
+  EXPECT_LT(BigInt("-99999999999999999999").compare(-9223372036854775807LL),
+            0);
+  EXPECT_GT(BigInt(-5).compare(std::string_view("-0006")), 0);
+  EXPECT_GT(BigInt(5).compare(0), 0);
+  EXPECT_EQ(BigInt(-5).compare(std::string("-5")), 0);
+  EXPECT_LT(BigInt(-5).compare("4"), 0);
+}
+
+TEST(Hashing, ContainerKeys) {
+  BigInt key("-123456789012345678901234567890");
+  EXPECT_EQ(std::hash<BigInt>()(key), key.hash());
+  EXPECT_NE(key.hash(), key.hash(1));
+  EXPECT_NE(key.hash(), (-key).hash());
+  EXPECT_EQ(BigIntHash()(BigInt(-42)), BigIntHash()(-42));
+  EXPECT_EQ(BigIntHash()(BigInt(-42)), BigIntHash()("-0042"));
+  EXPECT_EQ(BigIntHash()(BigInt(0)), BigIntHash()(0));
+  EXPECT_EQ(BigIntHash()(BigInt(-42)), BigIntHash()(std::string("-42")));
+
+  std::unordered_map<BigInt, int> counts;
+  counts[key] = 1;
+  counts[BigInt("-123456789012345678901234567890")] += 1;
+  EXPECT_EQ(counts.size(), 1u);
+  EXPECT_EQ(counts[key], 2);
+
+  std::map<BigInt, int, BigIntLess> sorted{{BigInt(-3), 0}, {BigInt(7), 1}};
+  EXPECT_EQ(sorted.find(7)->second, 1);
+  EXPECT_EQ(sorted.find("-3")->second, 0);
+  EXPECT_EQ(sorted.find(std::string("7"))->second, 1);
+  EXPECT_EQ(sorted.find(8), sorted.end());
+}
+
+TEST(SharedStorage, CopyOnWrite) {
+  SharedBigInt a(BigInt("123456789012345678901234567890"));
+  SharedBigInt b = a;
+  EXPECT_EQ(a.useCount(), 2);
+  EXPECT_EQ(&a.get(), &b.get());
+  b += BigInt(10);
+  EXPECT_EQ(a.useCount(), 1);
+  EXPECT_EQ(a->toString(), "123456789012345678901234567890");
+  EXPECT_EQ(b->toString(), "123456789012345678901234567900");
+  const BigInt *storage = &b.get();
+  b %= BigInt(7);
+  EXPECT_EQ(&b.get(), storage);
+  EXPECT_EQ(*b, BigInt("123456789012345678901234567900") % 7);
+
+  BigInt from("-123456789");
+  BigInt to(std::move(from));
+  EXPECT_EQ(from.toString(), "0");
+  EXPECT_EQ(from.length(), 1);
+  from = std::move(to);
+  EXPECT_EQ(from.toString(), "-123456789");
+  EXPECT_EQ(to, BigInt(0));
+  from = std::move(from);
+  EXPECT_EQ(from.toString(), "-123456789");
+
+  SharedBigInt source(BigInt(42));
+  SharedBigInt target(std::move(source));
+  EXPECT_EQ(*source, BigInt(0));
+  source += BigInt(1);
+  EXPECT_EQ(*source, BigInt(1));
+  SharedBigInt other;
+  other = std::move(target);
+  EXPECT_EQ(target->length(), 1);
+  target *= BigInt(5);
+  EXPECT_EQ(*target, BigInt(0));
+  EXPECT_EQ(*other, BigInt(42));
+  EXPECT_EQ(SharedBigInt().get(), BigInt(0));
+}
+
+TEST(SharedStorage, FanOutAcrossThreads) {
+  SharedBigInt value(BigInt("-98765432109876543210"));
+  std::vector<std::thread> threads;
+  std::vector<BigInt> results(4);
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([value, i, &results]() mutable {
+      value *= BigInt(i);
+      results[i] = *value;
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(results[i], BigInt("-98765432109876543210") * i);
+  }
+  EXPECT_EQ(value->toString(), "-98765432109876543210");
+}